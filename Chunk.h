@@ -0,0 +1,48 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHUNK_H_
+#define CHUNK_H_
+
+#include "fmatdef.h"
+
+/*
+ * Layout of the image of a PKT_IMG_4bit_CHUNK (SIZE_8x8 bytes): like the
+ * frame buffers, the chunk is made of 3 color planes (in the R/G/B order
+ * of fmatdef.h, i.e. the order of MAKE_RGB), each of 8 rows; a row holds
+ * 8 pixels of COLOR_DEPTH bits, the leftmost in the most significant bits.
+ */
+
+#define CHUNK_ROW_SIZE    (8 * COLOR_DEPTH / 8)    // bytes of 1 row of 1 color
+#define CHUNK_PLANE_SIZE  (8 * CHUNK_ROW_SIZE)     // bytes of 1 color
+
+namespace FlashMat {
+
+// Store the 4-bit value v for pixel (x, y) of color plane p.
+inline void chunkSetPixel(uint8_t img[SIZE_8x8], int p, int x, int y, uint8_t v)
+{
+    uint8_t *b = img + p * CHUNK_PLANE_SIZE + y * CHUNK_ROW_SIZE + x / 2;
+    if(x & 1)
+        *b = (*b & 0xF0) | (v & 0x0F);
+    else
+        *b = (*b & 0x0F) | (v << 4);
+}
+}
+
+#endif
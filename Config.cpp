@@ -0,0 +1,191 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Config.h"
+#include "Frame.h"
+
+
+namespace FlashMat
+{
+
+    // Store r, g, b in the buffer order (see MAKE_RGB).
+    static void setColor(int color[3], int r, int g, int b)
+    {
+        color[R] = r & 0xFF;
+        color[G] = g & 0xFF;
+        color[B] = b & 0xFF;
+    }
+
+    void configDefaults(Config *config)
+    {
+        setColor(config->color, 255, 127, 0);
+        setColor(config->bgColor, 0, 0, 0);
+        config->overlay = OVERLAY;
+        config->speed = TEXT_SPEED;
+        config->skewBudgetUs = SWAP_SKEW_BUDGET_US;
+        strcpy(config->statePath, STATE_FILE);
+        int addresses[CELLS] = { ADDRESS1, ADDRESS2, ADDRESS3, ADDRESS4 };
+        memset(config->region, 0, sizeof(config->region));
+        config->regions = 1;
+        strcpy(config->region[0].name, MAIN_REGION);
+        config->region[0].mode = -1;  // set from the command line
+        config->cells = CELLS;
+        for(int c = 0; c < CELLS; c++)
+        {
+            config->cell[c].address = addresses[c];
+            config->cell[c].region = 0;
+        }
+    }
+
+    static int findRegion(const Config *config, const char *name)
+    {
+        for(int r = 0; r < config->regions; r++)
+            if(strcmp(config->region[r].name, name) == 0)
+                return r;
+        return -1;
+    }
+
+    bool configSameLayout(const Config *a, const Config *b)
+    {
+        if(a->regions != b->regions || a->cells != b->cells)
+            return false;
+        for(int r = 1; r < a->regions; r++)
+            if(strcmp(a->region[r].name, b->region[r].name) != 0
+                    || a->region[r].mode != b->region[r].mode
+                    || a->region[r].speed != b->region[r].speed
+                    || strcmp(a->region[r].value, b->region[r].value) != 0)
+                return false;
+        for(int c = 0; c < a->cells; c++)
+            if(a->cell[c].address != b->cell[c].address
+                    || a->cell[c].region != b->cell[c].region)
+                return false;
+        return true;
+    }
+
+    int configLoad(Config *config, const char *path)
+    {
+        FILE *input = fopen(path, "r");
+        if(input == NULL)
+            return -1;
+        Config loaded = *config;
+        char line[CONFIG_PATH_SIZE + 32];
+        char cellRegion[CELLS][REGION_NAME_SIZE];
+        int cellLine[CELLS];
+        int lineNo = 0;
+        loaded.cells = 0;
+        while(fgets(line, sizeof(line), input))
+        {
+            lineNo++;
+            char *comment = strchr(line, '#');
+            if(comment != NULL)
+                *comment = '\0';
+            char key[32];
+            int r, g, b, value, n;
+            if(sscanf(line, "%31s%n", key, &n) != 1)
+                continue;  // blank line
+            const char *args = line + n;
+            bool ok;
+            if(strcmp(key, "color") == 0)
+            {
+                ok = sscanf(args, "%d %d %d", &r, &g, &b) == 3;
+                if(ok)
+                    setColor(loaded.color, r, g, b);
+            }
+            else if(strcmp(key, "bgcolor") == 0)
+            {
+                ok = sscanf(args, "%d %d %d", &r, &g, &b) == 3;
+                if(ok)
+                    setColor(loaded.bgColor, r, g, b);
+            }
+            else if(strcmp(key, "overlay") == 0)
+            {
+                ok = sscanf(args, "%d", &value) == 1;
+                if(ok)
+                    loaded.overlay = value != 0;
+            }
+            else if(strcmp(key, "speed") == 0)
+            {
+                ok = sscanf(args, "%d", &value) == 1 && value > 0;
+                if(ok)
+                    loaded.speed = value;
+            }
+            else if(strcmp(key, "skew_budget") == 0)
+            {
+                ok = sscanf(args, "%d", &value) == 1 && value >= 0;
+                if(ok)
+                    loaded.skewBudgetUs = value;
+            }
+            else if(strcmp(key, "state") == 0)
+                ok = sscanf(args, "%255s", loaded.statePath) == 1;
+            else if(strcmp(key, "region") == 0)
+            {
+                RegionConfig *region = &loaded.region[loaded.regions];
+                ok = loaded.regions < REGIONS_MAX
+                     && sscanf(args, "%15s %d %d %n", region->name, &region->mode,
+                               &region->speed, &n) == 3
+                     && region->speed > 0
+                     && findRegion(&loaded, region->name) < 0;
+                if(ok)
+                {
+                    // The value is the rest of the line.
+                    strncpy(region->value, args + n, CONFIG_PATH_SIZE - 1);
+                    region->value[strcspn(region->value, "\n")] = '\0';
+                    loaded.regions++;
+                }
+            }
+            else if(strcmp(key, "cell") == 0)
+            {
+                ok = loaded.cells < CELLS && sscanf(args, "%i %15s",
+                        &loaded.cell[loaded.cells].address,
+                        cellRegion[loaded.cells]) == 2;
+                if(ok)
+                    cellLine[loaded.cells++] = lineNo;
+            }
+            else
+                ok = false;
+            if(!ok)
+                fprintf(stderr, "%s:%d: ignoring \"%s\"\n", path, lineNo, key);
+        }
+        fclose(input);
+        if(loaded.cells == 0)
+        {
+            // No cell lines: the default layout.
+            loaded.cells = config->cells;
+            memcpy(loaded.cell, config->cell, sizeof(loaded.cell));
+        }
+        else
+            for(int c = 0; c < loaded.cells; c++)
+            {
+                // Regions can be defined after their cells.
+                loaded.cell[c].region = findRegion(&loaded, cellRegion[c]);
+                if(loaded.cell[c].region < 0)
+                {
+                    fprintf(stderr, "%s:%d: unknown region \"%s\"\n", path,
+                            cellLine[c], cellRegion[c]);
+                    loaded.cell[c].region = 0;
+                }
+            }
+        *config = loaded;
+        return 0;
+    }
+
+}
@@ -0,0 +1,102 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include "Settings.h"
+
+#define CONFIG_PATH_SIZE  256
+#define REGION_NAME_SIZE   16
+#define MAIN_REGION       "main"
+
+namespace FlashMat {
+
+/**
+ * Runtime settings, read from an optional configuration file and reloaded
+ * on SIGHUP. The file has one "key value" per line; '#' starts a comment:
+ *
+ *    color 255 127 0       # text color (R G B)
+ *    bgcolor 0 0 0         # background color (R G B)
+ *    overlay 0             # transparent background
+ *    speed 30              # milliseconds per frame (the more, the slowest)
+ *    skew_budget 1000      # see SWAP_SKEW_BUDGET_US
+ *    state tweetmachine.state  # where the state is saved for warm restarts
+ *
+ * The cells can be split into regions, each showing its own input at its
+ * own speed. The "main" region shows the input given on the command line,
+ * at the speed above; more regions are added with
+ *
+ *    region <name> <mode> <speed> <value>
+ *
+ * (mode and value as on the command line; mode 2 shows the local time,
+ * value being a strftime() format, redrawn every speed milliseconds; a
+ * time too wide for its region scrolls at the main speed instead, and is
+ * refreshed at the start of each pass).
+ * Cells are assigned to regions, left to right, with
+ *
+ *    cell <address> <region name>
+ *
+ * Without cell lines, the four cells of Settings.h make up the main region.
+ * Missing keys keep their default (see Settings.h). Regions and cells are
+ * only read at startup.
+ */
+struct RegionConfig
+{
+    char name[REGION_NAME_SIZE];
+    int mode;
+    int speed;
+    char value[CONFIG_PATH_SIZE];
+};
+
+struct CellConfig
+{
+    int address;
+    int region;         // index in Config::region
+};
+
+struct Config
+{
+    int color[3];       // in the R/G/B order of fmatdef.h (as MAKE_RGB)
+    int bgColor[3];
+    bool overlay;
+    int speed;
+    unsigned int skewBudgetUs;
+    char statePath[CONFIG_PATH_SIZE];
+    int regions;        // region 0 is the main one
+    RegionConfig region[REGIONS_MAX];
+    int cells;
+    CellConfig cell[CELLS];
+};
+
+void configDefaults(Config *config);
+
+/**
+ * Read path over the current values of config.
+ * Returns 0 on success, -1 if the file cannot be read (config is unchanged).
+ */
+int configLoad(Config *config, const char *path);
+
+/**
+ * True if a and b have the same regions and cells.
+ */
+bool configSameLayout(const Config *a, const Config *b);
+}
+
+#endif
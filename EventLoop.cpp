@@ -0,0 +1,174 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+
+#include "EventLoop.h"
+
+
+namespace FlashMat
+{
+
+    int eventLoopWatch(EventLoop *loop, const char *path)
+    {
+        if(loop->watches == EVENT_MAX_WATCHES)
+            return -1;
+        char dir[PATH_MAX];
+        const char *slash = strrchr(path, '/');
+        const char *name = path;
+        if(slash == NULL)
+            strcpy(dir, ".");
+        else
+        {
+            int len = (slash == path) ? 1 : slash - path;
+            if(len >= PATH_MAX)
+                return -1;
+            memcpy(dir, path, len);
+            dir[len] = '\0';
+            name = slash + 1;
+        }
+        int wd = inotify_add_watch(loop->inotifyfd, dir,
+                                   IN_CLOSE_WRITE | IN_MOVED_TO);
+        if(wd < 0)
+            return -1;
+        int index = loop->watches++;
+        loop->watch[index] = wd;
+        strncpy(loop->watchName[index], name, sizeof(loop->watchName[index]) - 1);
+        return index;
+    }
+
+    static int addFd(int epfd, int fd)
+    {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        return epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    int eventLoopInit(EventLoop *loop)
+    {
+        memset(loop, 0, sizeof(*loop));
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGINT);
+        sigaddset(&mask, SIGTERM);
+        sigaddset(&mask, SIGHUP);
+        sigaddset(&mask, SIGUSR1);
+        // Signals must be blocked to be read from the signalfd only.
+        if(sigprocmask(SIG_BLOCK, &mask, NULL) < 0)
+            return -1;
+        loop->epfd = epoll_create1(EPOLL_CLOEXEC);
+        loop->timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        loop->signalfd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+        loop->inotifyfd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if(loop->epfd < 0 || loop->timerfd < 0 || loop->signalfd < 0
+                || loop->inotifyfd < 0)
+            return -1;
+        if(addFd(loop->epfd, loop->timerfd) < 0
+                || addFd(loop->epfd, loop->signalfd) < 0
+                || addFd(loop->epfd, loop->inotifyfd) < 0)
+            return -1;
+        return 0;
+    }
+
+    int eventLoopSchedule(EventLoop *loop, int delayMs)
+    {
+        struct itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        if(delayMs >= 0)
+        {
+            spec.it_value.tv_sec = delayMs / 1000;
+            spec.it_value.tv_nsec = (long)(delayMs % 1000) * 1000000L;
+            // A zero it_value would disarm the timer.
+            if(delayMs == 0)
+                spec.it_value.tv_nsec = 1;
+        }
+        return timerfd_settime(loop->timerfd, 0, &spec, NULL);
+    }
+
+    // Drain the inotify queue; returns the bitmask of the watches that changed.
+    static int inputChanged(EventLoop *loop)
+    {
+        char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+        int changed = 0;
+        ssize_t len;
+        while((len = read(loop->inotifyfd, buf, sizeof(buf))) > 0)
+        {
+            for(char *p = buf; p < buf + len;)
+            {
+                struct inotify_event *ev = (struct inotify_event *)p;
+                for(int w = 0; w < loop->watches; w++)
+                    if(ev->len > 0 && ev->wd == loop->watch[w]
+                            && strcmp(ev->name, loop->watchName[w]) == 0)
+                        changed |= 1 << w;
+                p += sizeof(struct inotify_event) + ev->len;
+            }
+        }
+        return changed;
+    }
+
+    Event eventLoopWait(EventLoop *loop, int *arg)
+    {
+        while(true)
+        {
+            struct epoll_event ev;
+            int n = epoll_wait(loop->epfd, &ev, 1, -1);
+            if(n < 0 && errno == EINTR)
+                continue;
+            if(n < 0)
+                return EV_ERROR;
+            if(ev.data.fd == loop->signalfd)
+            {
+                struct signalfd_siginfo info;
+                if(read(loop->signalfd, &info, sizeof(info)) != sizeof(info))
+                    continue;
+                *arg = info.ssi_signo;
+                return EV_SIGNAL;
+            }
+            if(ev.data.fd == loop->timerfd)
+            {
+                uint64_t expirations;
+                if(read(loop->timerfd, &expirations, sizeof(expirations)) > 0)
+                    return EV_TIMER;
+                continue;
+            }
+            if(ev.data.fd == loop->inotifyfd && (*arg = inputChanged(loop)) != 0)
+                return EV_INPUT;
+        }
+    }
+
+    void eventLoopClose(EventLoop *loop)
+    {
+        close(loop->inotifyfd);
+        close(loop->signalfd);
+        close(loop->timerfd);
+        close(loop->epfd);
+    }
+
+}
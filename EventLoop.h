@@ -0,0 +1,79 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVENTLOOP_H_
+#define EVENTLOOP_H_
+
+#define EVENT_MAX_WATCHES  8
+
+namespace FlashMat {
+
+enum Event {
+    EV_ERROR  = -1,
+    EV_TIMER  =  0,  // the timer expired
+    EV_INPUT  =  1,  // some watched input file has been rewritten
+    EV_SIGNAL =  2   // a signal has been received
+};
+
+/**
+ * An epoll instance multiplexing a one-shot timer (timerfd), the input
+ * change notifications (inotify) and the signals (signalfd).
+ * While the timer is disarmed and nothing happens, eventLoopWait() sleeps
+ * with no wakeups at all.
+ */
+struct EventLoop
+{
+    int epfd;
+    int timerfd;
+    int inotifyfd;
+    int signalfd;
+    int watches;
+    int watch[EVENT_MAX_WATCHES];     // inotify watch on the input directory
+    char watchName[EVENT_MAX_WATCHES][256];  // the input file in that directory
+};
+
+/**
+ * Set up the loop. SIGINT, SIGTERM, SIGHUP and SIGUSR1 are blocked and
+ * delivered through the signalfd.
+ * Returns 0 on success, -1 on error.
+ */
+int eventLoopInit(EventLoop *loop);
+
+/**
+ * Report rewrites of path as EV_INPUT (its directory is watched, so that
+ * replacing the file works too). Returns the index of the watch, -1 on error.
+ */
+int eventLoopWatch(EventLoop *loop, const char *path);
+
+/**
+ * Make the timer expire once, delayMs milliseconds from now (0 means as
+ * soon as possible); a negative delay disarms it.
+ */
+int eventLoopSchedule(EventLoop *loop, int delayMs);
+
+/**
+ * Wait for the next event. For EV_SIGNAL, *arg is set to the signal number;
+ * for EV_INPUT, to the bitmask of the watches (by index) that changed.
+ */
+Event eventLoopWait(EventLoop *loop, int *arg);
+
+void eventLoopClose(EventLoop *loop);
+}
+
+#endif
@@ -0,0 +1,282 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Feed.h"
+#include "Text.h"
+
+
+namespace FlashMat
+{
+
+    static void reset(Feed *feed)
+    {
+        feed->fd = -1;
+        feed->mem = NULL;
+        feed->memLen = 0;
+        feed->eof = false;
+        feed->rawLen = 0;
+        feed->link = false;
+        for(int i = 0; i < LEAD_IN; i++)
+            feed->window[i] = ' ';
+        feed->start = 0;
+        feed->end = LEAD_IN;
+        feed->consumed = 0;
+        feed->message = 0;
+        feed->messageOffset = 0;
+        feed->stars = 0;
+        feed->size = -1;
+        feed->mtime = -1;
+        feed->rawPos = 0;
+        memset(&feed->mark, 0, sizeof(feed->mark));
+        feed->pendingAt = -1;
+    }
+
+    int feedOpenFile(Feed *feed, const char *path)
+    {
+        reset(feed);
+        feed->normalize = true;
+        feed->fd = open(path, O_RDONLY | O_CLOEXEC);
+        if(feed->fd < 0)
+        {
+            feed->eof = true;
+            return -1;
+        }
+        struct stat st;
+        if(fstat(feed->fd, &st) == 0)
+        {
+            feed->size = st.st_size;
+            feed->mtime = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+        }
+        return 0;
+    }
+
+    void feedOpenString(Feed *feed, const char *text)
+    {
+        reset(feed);
+        feed->normalize = false;
+        feed->mem = text;
+        feed->memLen = strlen(text);
+    }
+
+    void feedClose(Feed *feed)
+    {
+        if(feed->fd >= 0)
+            close(feed->fd);
+        feed->fd = -1;
+        feed->eof = true;
+    }
+
+    // Read the next chunk of raw input after the carried-over bytes.
+    static int readChunk(Feed *feed)
+    {
+        if(feed->fd < 0)
+        {
+            int n = feed->memLen < FEED_CHUNK ? feed->memLen : FEED_CHUNK;
+            memcpy(feed->raw + feed->rawLen, feed->mem, n);
+            feed->mem += n;
+            feed->memLen -= n;
+            return n;
+        }
+        ssize_t n;
+        do
+            n = read(feed->fd, feed->raw + feed->rawLen, FEED_CHUNK);
+        while(n < 0 && errno == EINTR);
+        return n > 0 ? n : 0;
+    }
+
+    // Length of the prefix of raw that can be normalized now: up to the last
+    // blank, so that no link or UTF-8 sequence is split across two chunks.
+    static int completePrefix(const char *raw, int len)
+    {
+        int cut = len;
+        while(cut > 0 && raw[cut - 1] != ' ' && raw[cut - 1] != '\n')
+            cut--;
+        if(len - cut <= FEED_CARRY)
+            return cut;
+        // Carry limit exceeded: cut anyway, but not inside a UTF-8 sequence
+        // (a link cut here is still removed whole, see parserChunk()).
+        cut = len - FEED_CARRY;
+        while(cut < len && ((unsigned char)raw[cut] & 0xC0) == 0x80)
+            cut++;
+        // Nor inside the "http://" that starts a link (the cut is at least
+        // FEED_CARRY bytes before len, so moving it forward is safe).
+        for(int k = 1; k < 8 && k <= cut; k++)
+        {
+            if(memcmp(raw + cut - k, "https://", 8) == 0)
+                return cut - k + 8;
+            if(k < 7 && memcmp(raw + cut - k, "http://", 7) == 0)
+                return cut - k + 7;
+        }
+        return cut;
+    }
+
+    // Normalize one more chunk of input into the window.
+    static void refill(Feed *feed)
+    {
+        // Slide the unconsumed characters to the front of the window.
+        int avail = feed->end - feed->start;
+        memmove(feed->window, feed->window + feed->start, avail);
+        if(feed->pendingAt >= 0)
+            feed->pendingAt -= feed->start;
+        feed->start = 0;
+        feed->end = avail;
+
+        // The text normalized now starts at this byte of the input (which
+        // is a mark only if the previous chunk did not end inside a link).
+        long long raw = feed->rawPos - feed->rawLen;
+        bool link = feed->link;
+        int at = feed->end;
+        int n = readChunk(feed);
+        feed->rawPos += n;
+        if(n == 0)
+            feed->eof = true;
+        int len = feed->rawLen + n;
+        int cut = feed->eof ? len : completePrefix(feed->raw, len);
+        char saved = feed->raw[cut];
+        feed->raw[cut] = '\0';
+        if(feed->normalize)
+            feed->end += parserChunk(feed->raw, feed->window + feed->end,
+                                     &feed->link);
+        else
+        {
+            memcpy(feed->window + feed->end, feed->raw, cut);
+            feed->end += cut;
+        }
+        feed->raw[cut] = saved;
+        if(feed->end > at && feed->pendingAt < 0 && !link)
+        {
+            feed->pendingRaw = raw;
+            feed->pendingAt = at;
+        }
+        feed->rawLen = len - cut;
+        memmove(feed->raw, feed->raw + cut, feed->rawLen);
+    }
+
+    int feedPeek(Feed *feed, char *out, int n)
+    {
+        while(feed->end - feed->start < n && !(feed->eof && feed->rawLen == 0))
+            refill(feed);
+        int avail = feed->end - feed->start;
+        if(avail > n)
+            avail = n;
+        memcpy(out, feed->window + feed->start, avail);
+        out[avail] = '\0';
+        return avail;
+    }
+
+    void feedAdvance(Feed *feed)
+    {
+        if(feed->start < feed->end)
+        {
+            if(feed->start == feed->pendingAt)
+            {
+                FeedMark *mark = &feed->mark;
+                mark->raw = feed->pendingRaw;
+                mark->consumed = feed->consumed;
+                mark->message = feed->message;
+                mark->messageOffset = feed->messageOffset;
+                mark->stars = feed->stars;
+                feed->pendingAt = -1;
+            }
+            char c = feed->window[feed->start++];
+            feed->consumed++;
+            // A message starts after a separator.
+            if(c != '*' && feed->stars >= MESSAGE_SEPARATOR)
+            {
+                feed->message++;
+                feed->messageOffset = 0;
+            }
+            feed->stars = (c == '*') ? feed->stars + 1 : 0;
+            feed->messageOffset++;
+        }
+    }
+
+    bool feedSeek(Feed *feed, unsigned long message, unsigned long offset)
+    {
+        char c[2];
+        while(feed->message < message
+                || (feed->message == message && feed->messageOffset < offset))
+        {
+            if(feedPeek(feed, c, 1) == 0)
+                return false;
+            feedAdvance(feed);
+        }
+        // If the input has changed we might be inside a glyph token.
+        while(feedPeek(feed, c, 1) == 1 && (c[0] & 0x80))
+            feedAdvance(feed);
+        return true;
+    }
+
+    bool feedResume(Feed *feed, const FeedMark *mark, unsigned long consumed)
+    {
+        if(feed->fd < 0 || feed->consumed > 0 || consumed < mark->consumed)
+            return false;
+        // A mark with nothing consumed is the very start of the input.
+        if(mark->consumed > 0)
+        {
+            if(lseek(feed->fd, mark->raw, SEEK_SET) < 0)
+                return false;
+            // Drop what has been read ahead from the start.
+            feed->eof = false;
+            feed->rawLen = 0;
+            feed->link = false;
+            feed->rawPos = mark->raw;
+            feed->pendingAt = -1;
+            // The lead-in is behind.
+            feed->start = LEAD_IN;
+            feed->end = LEAD_IN;
+            feed->consumed = mark->consumed;
+            feed->message = mark->message;
+            feed->messageOffset = mark->messageOffset;
+            feed->stars = mark->stars;
+            feed->mark = *mark;
+        }
+        char c[2];
+        while(feed->consumed < consumed)
+        {
+            if(feedPeek(feed, c, 1) == 0)
+                return false;
+            feedAdvance(feed);
+        }
+        return true;
+    }
+
+    const char *feedAll(Feed *feed)
+    {
+        if(feed->consumed > 0)
+            return NULL;
+        char probe[FEED_AHEAD + 1];
+        feedPeek(feed, probe, FEED_AHEAD);
+        // Reading once more tells whether the input ends here.
+        while(!(feed->eof && feed->rawLen == 0)
+                && feed->end < LEAD_IN + FEED_AHEAD)
+            refill(feed);
+        if(!feed->eof || feed->rawLen > 0)
+            return NULL;
+        feed->window[feed->end] = '\0';
+        return feed->window + LEAD_IN;
+    }
+
+}
@@ -0,0 +1,138 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FEED_H_
+#define FEED_H_
+
+#include <stddef.h>
+
+#include "Settings.h"
+#include "Text.h"
+
+// Messages are separated by (at least) 3 stars, see download.py.
+#define MESSAGE_SEPARATOR  3
+
+// Raw bytes read from the input at each refill.
+#define FEED_CHUNK   1024
+// Longest unterminated word kept back for the next refill: links and UTF-8
+// sequences are only normalized once they are complete.
+#define FEED_CARRY    256
+// Bytes that must be available ahead of the scroll position (glyph tokens
+// take more than one byte).
+#define FEED_AHEAD     60
+#define FEED_WINDOW  (LEAD_IN + FEED_AHEAD + PARSER_OUT_SIZE(FEED_CHUNK + FEED_CARRY))
+
+namespace FlashMat {
+
+/**
+ * A point of the input where the normalization can start over: the first
+ * byte of a chunk (chunks are cut at blanks), with the counters of the feed
+ * (see below) when the text of that chunk is reached.
+ */
+struct FeedMark
+{
+    long long raw;      // offset of the chunk in the input
+    unsigned long consumed;
+    unsigned long message;
+    unsigned long messageOffset;
+    int stars;
+};
+
+/**
+ * A lazily-parsed input: the file (or string) is read in chunks of
+ * FEED_CHUNK bytes and only a small sliding window of normalized text is
+ * kept ahead of the scroll position, so memory and startup time do not
+ * depend on the size of the input.
+ *
+ * The window always starts with LEAD_IN blanks, as the scroller expects.
+ */
+struct Feed
+{
+    int fd;             // input file, or -1 for a string / closed feed
+    const char *mem;    // string input (not normalized), when fd == -1
+    size_t memLen;
+    bool eof;           // nothing more to read from the input
+    bool normalize;     // pass the input through parser()
+    bool link;          // the last chunk normalized ends inside a link
+    char raw[FEED_CARRY + FEED_CHUNK + 1];
+    int rawLen;         // bytes in raw not yet normalized
+    char window[FEED_WINDOW + 1];
+    int start;          // first character of the window not consumed yet
+    int end;            // end of the normalized characters in window
+    unsigned long consumed;  // characters consumed since the feed was opened
+    unsigned long message;   // messages (see MESSAGE_SEPARATOR) consumed
+    unsigned long messageOffset;  // characters consumed in the current message
+    int stars;          // length of the current run of '*'
+    long long size;     // size of the input file when opened (-1 for a string)
+    long long mtime;    // and its modification time, in nanoseconds
+    long long rawPos;   // bytes read from the input
+    FeedMark mark;      // the last chunk start consumed
+    long long pendingRaw;  // the next chunk start, at window[pendingAt]
+    int pendingAt;      // -1 if not known yet
+};
+
+/**
+ * Open path for streaming; the text is normalized with parser().
+ * Returns 0 on success, -1 if the file cannot be opened (the feed is then
+ * empty).
+ */
+int feedOpenFile(Feed *feed, const char *path);
+
+/**
+ * Stream a string as it is (no normalization). The string is not copied.
+ */
+void feedOpenString(Feed *feed, const char *text);
+
+void feedClose(Feed *feed);
+
+/**
+ * Make up to n characters ahead of the current position available, reading
+ * from the input if needed, and copy them (NUL-terminated) into out.
+ * Returns the number of characters copied: 0 means the feed is over.
+ */
+int feedPeek(Feed *feed, char *out, int n);
+
+/**
+ * Consume the character at the current position.
+ */
+void feedAdvance(Feed *feed);
+
+/**
+ * Consume characters until the position (message, offset) is reached, as
+ * counted by feed->message and feed->messageOffset.
+ * Returns false (the feed is then over) if the input is shorter.
+ */
+bool feedSeek(Feed *feed, unsigned long message, unsigned long offset);
+
+/**
+ * Go straight to the position of a feed that had consumed characters
+ * after passing mark, without parsing the input before mark. Only valid
+ * for a file opened (nothing consumed yet) and unchanged since the mark was
+ * taken (compare size and mtime). Returns false if the position cannot be reached.
+ */
+bool feedResume(Feed *feed, const FeedMark *mark, unsigned long consumed);
+
+/**
+ * If the whole input fits in the window, return it (without the lead-in);
+ * otherwise return NULL.
+ */
+const char *feedAll(Feed *feed);
+}
+
+#endif
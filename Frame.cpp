@@ -0,0 +1,88 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <wiringPi.h>
+
+#include "Frame.h"
+
+
+namespace FlashMat
+{
+
+    void initSkewStats(SkewStats *stats, unsigned int budgetUs)
+    {
+        memset(stats, 0, sizeof(*stats));
+        stats->budgetUs = budgetUs;
+    }
+
+    int stageFrame(int fds[], int n, int x, int y)
+    {
+        int errors = 0;
+        // Positions first, then draws: the draws are the slow part on the
+        // cell side, so they overlap with the bus traffic of the others.
+        for(int i = 0; i < n; i++)
+            if(sendTextPosition(fds[i], x, y) < 0)
+                errors++;
+        for(int i = 0; i < n; i++)
+            if(sendDrawText(fds[i]) < 0)
+                errors++;
+        return errors;
+    }
+
+    int commitFrame(int fds[], int n, SkewStats *stats)
+    {
+        // The swap packet is built once and the writes are issued in a
+        // tight loop: anything between them widens the tearing window.
+        int type[1] = { SWAP_SYNC };
+        int errors = 0;
+        unsigned int first = 0, last = 0;
+        for(int i = 0; i < n; i++)
+        {
+            if(writeBlock(fds[i], PKT_SWAP, type, 1) < 0)
+                errors++;
+            last = micros();
+            if(i == 0)
+                first = last;
+        }
+        if(stats != NULL && n > 0)
+        {
+            unsigned int skew = last - first;
+            stats->frames++;
+            stats->lastUs = skew;
+            stats->totalUs += skew;
+            if(skew > stats->maxUs)
+                stats->maxUs = skew;
+            if(skew > stats->budgetUs)
+                stats->overBudget++;
+        }
+        return errors;
+    }
+
+    void reportSkew(FILE *out, const SkewStats *stats)
+    {
+        unsigned long avg = stats->frames ?
+                            (unsigned long)(stats->totalUs / stats->frames) : 0;
+        fprintf(out, "swap skew: %lu frames, avg %lu us, max %u us, "
+                "%lu over the %u us budget\n", stats->frames, avg,
+                stats->maxUs, stats->overBudget, stats->budgetUs);
+    }
+
+}
@@ -0,0 +1,73 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FRAME_H_
+#define FRAME_H_
+
+#include <stdio.h>
+
+#include "PiCommander.h"
+
+// Maximum tolerated time (in microseconds) between the first and the last
+// swap of a frame. Override at build time with -DSWAP_SKEW_BUDGET_US=...
+#ifndef SWAP_SKEW_BUDGET_US
+#define SWAP_SKEW_BUDGET_US  1000
+#endif
+
+// How many frames are committed between two skew reports.
+#ifndef SWAP_SKEW_REPORT_FRAMES
+#define SWAP_SKEW_REPORT_FRAMES  2000
+#endif
+
+namespace FlashMat {
+
+/**
+ * Statistics about the skew between the first and the last swap of each
+ * committed frame, i.e. how far apart in time the cells flip their buffers.
+ */
+struct SkewStats
+{
+    unsigned int budgetUs;      // frames above this skew are counted as late
+    unsigned long frames;       // committed frames
+    unsigned long overBudget;   // frames whose skew exceeded budgetUs
+    unsigned int lastUs;        // skew of the last committed frame
+    unsigned int maxUs;         // worst skew seen so far
+    unsigned long long totalUs; // sum of all skews (for the average)
+    unsigned long reported;     // frames at the last report
+};
+
+void initSkewStats(SkewStats *stats, unsigned int budgetUs);
+
+/**
+ * Stage a frame: position the text and draw it in the back buffer of every
+ * cell. Nothing becomes visible until commitFrame() is called.
+ */
+int stageFrame(int fds[], int n, int x, int y);
+
+/**
+ * Commit a staged frame: send SWAP_SYNC to every cell back-to-back, with no
+ * other work between the writes, and account the resulting skew in stats
+ * (which may be NULL). Returns the number of failed swaps.
+ */
+int commitFrame(int fds[], int n, SkewStats *stats);
+
+void reportSkew(FILE *out, const SkewStats *stats);
+}
+
+#endif
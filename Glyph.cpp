@@ -0,0 +1,225 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "Chunk.h"
+#include "Glyph.h"
+#include "PiCommander.h"
+#include "Text.h"
+
+
+namespace FlashMat
+{
+
+    static const GlyphBitmap *findGlyph(long cp)
+    {
+        int lo = 0, hi = glyphFontSize - 1;
+        while(lo <= hi)
+        {
+            int mid = (lo + hi) / 2;
+            if(cp < (long)glyphFont[mid].first)
+                hi = mid - 1;
+            else if(cp > (long)glyphFont[mid].last)
+                lo = mid + 1;
+            else
+                return &glyphFont[mid];
+        }
+        return NULL;
+    }
+
+    bool glyphAvailable(long cp)
+    {
+        return cp >= 0 && findGlyph(cp) != NULL;
+    }
+
+    int glyphEncode(long cp, char *out)
+    {
+        out[0] = GLYPH_ESC;
+        out[1] = (char)(0x80 | ((cp >> 14) & 0x7F));
+        out[2] = (char)(0x80 | ((cp >> 7) & 0x7F));
+        out[3] = (char)(0x80 | (cp & 0x7F));
+        return GLYPH_TOKEN_LEN;
+    }
+
+    static long glyphDecode(const char *token)
+    {
+        return ((long)(token[1] & 0x7F) << 14) | ((token[2] & 0x7F) << 7)
+               | (token[3] & 0x7F);
+    }
+
+    // Blanks needed to leave GLYPH_SPACE_WIDTH free pixels on both sides.
+    static int placeholderLen(int width)
+    {
+        return (width + 3 * GLYPH_SPACE_WIDTH - 1) / GLYPH_SPACE_WIDTH;
+    }
+
+    int glyphExpand(const char *text, int len, char *out, int outMax,
+                    GlyphRef refs[], int *nRefs, int *width, int *firstLen)
+    {
+        int i = 0, o = 0, x = 0;
+        *nRefs = 0;
+        *width = 0;
+        *firstLen = 0;
+        while(i < len && o < outMax)
+        {
+            int w, tokenLen;
+            if(text[i] == GLYPH_ESC)
+            {
+                if(i + GLYPH_TOKEN_LEN > len)
+                    break;
+                long cp = glyphDecode(text + i);
+                const GlyphBitmap *glyph = findGlyph(cp);
+                int gw = glyph != NULL ? glyph->width : 0;
+                int blanks = placeholderLen(gw);
+                if(o + blanks > outMax || *nRefs == GLYPH_MAX_REFS)
+                    break;
+                w = blanks * GLYPH_SPACE_WIDTH;
+                refs[*nRefs].cp = cp;
+                refs[*nRefs].x = x + (w - gw) / 2;
+                (*nRefs)++;
+                memset(out + o, ' ', blanks);
+                o += blanks;
+                tokenLen = GLYPH_TOKEN_LEN;
+            }
+            else
+            {
+                char chars[2] = { text[i], '\0' };
+                w = displaylen(chars);
+                out[o++] = text[i];
+                tokenLen = 1;
+            }
+            if(i == 0)
+            {
+                *width = w;
+                *firstLen = tokenLen;
+            }
+            x += w;
+            i += tokenLen;
+        }
+        out[o] = '\0';
+        return i;
+    }
+
+    void glyphCacheInit(GlyphCache *cache)
+    {
+        memset(cache, 0, sizeof(*cache));
+        for(int e = 0; e < GLYPH_CACHE_SIZE; e++)
+            cache->entries[e].cp = -1;
+    }
+
+    static void rasterize(GlyphCacheEntry *entry, const GlyphBitmap *glyph,
+                          const uint8_t key[6])
+    {
+        entry->width = glyph->width;
+        for(int x = 0; x < glyph->width; x++)
+            for(int y = 0; y < GLYPH_ROWS; y++)
+            {
+                bool on = glyph->rows[y] & (0x80 >> x);
+                for(int p = 0; p < 3; p++)
+                    entry->pixels[x][p][y] = on ? key[p] : key[3 + p];
+            }
+    }
+
+    const GlyphCacheEntry *glyphCacheGet(GlyphCache *cache, long cp,
+                                         int color[3], int bgColor[3])
+    {
+        uint8_t key[6];
+        for(int p = 0; p < 3; p++)
+        {
+            // 8 bits per color down to COLOR_DEPTH.
+            key[p] = (color[p] & 0xFF) >> (8 - COLOR_DEPTH);
+            key[3 + p] = (bgColor[p] & 0xFF) >> (8 - COLOR_DEPTH);
+        }
+        cache->clock++;
+        GlyphCacheEntry *victim = &cache->entries[0];
+        for(int e = 0; e < GLYPH_CACHE_SIZE; e++)
+        {
+            GlyphCacheEntry *entry = &cache->entries[e];
+            if(entry->cp == cp && memcmp(entry->key, key, sizeof(key)) == 0)
+            {
+                entry->used = cache->clock;
+                cache->hits++;
+                return entry;
+            }
+            if(entry->used < victim->used)
+                victim = entry;
+        }
+        const GlyphBitmap *glyph = findGlyph(cp);
+        if(glyph == NULL)
+            return NULL;
+        cache->misses++;
+        victim->cp = cp;
+        memcpy(victim->key, key, sizeof(key));
+        victim->used = cache->clock;
+        rasterize(victim, glyph, key);
+        return victim;
+    }
+
+    // Compose and send the chunk of cell fd whose left edge is at chunkX.
+    static int sendGlyphChunk(int fd, int col, int row, int chunkX,
+                              const GlyphCacheEntry *entry, int gx)
+    {
+        uint8_t img[SIZE_8x8];
+        for(int x = 0; x < 8; x++)
+        {
+            int src = chunkX + x - gx;
+            for(int p = 0; p < 3; p++)
+                for(int y = 0; y < 8; y++)
+                {
+                    // Outside the glyph: the background color.
+                    uint8_t v = (src >= 0 && src < entry->width)
+                                ? entry->pixels[src][p][y] : entry->key[3 + p];
+                    chunkSetPixel(img, p, x, y, v);
+                }
+        }
+        return sendImg4bitChunk(fd, col, row, img);
+    }
+
+    int drawGlyphs(GlyphCache *cache, const GlyphRef refs[], int nRefs,
+                   int x, int y, int fds[], int n, int color[3], int bgColor[3])
+    {
+        int errors = 0;
+        int row = y / 8;
+        if(y < 0 || row >= MATRIX_ROWS / 8)
+            return 0;
+        for(int r = 0; r < nRefs; r++)
+        {
+            const GlyphCacheEntry *entry = glyphCacheGet(cache, refs[r].cp,
+                                                         color, bgColor);
+            if(entry == NULL)
+                continue;
+            int gx = x + refs[r].x;
+            for(int c = 0; c < n; c++)
+            {
+                int cellX = c * MATRIX_COLS;
+                for(int col = 0; col < MATRIX_COLS / 8; col++)
+                {
+                    int chunkX = cellX + col * 8;
+                    if(chunkX + 8 <= gx || chunkX >= gx + entry->width)
+                        continue;
+                    if(sendGlyphChunk(fds[c], col, row, chunkX, entry, gx) < 0)
+                        errors++;
+                }
+            }
+        }
+        return errors;
+    }
+
+}
@@ -0,0 +1,126 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLYPH_H_
+#define GLYPH_H_
+
+#include <inttypes.h>
+
+#include "fmatdef.h"
+#include "Settings.h"
+
+/*
+ * Host-rendered glyphs, for the characters that the cell fonts cannot draw.
+ *
+ * parser() replaces such a character with a glyph token: GLYPH_ESC followed
+ * by the code point in 3 bytes of 7 bits (the high bit set, so that the
+ * token never contains a 0). Before the text is sent to the cells, every
+ * token is expanded into blanks (the placeholder); the glyph is then drawn
+ * by the host with PKT_IMG_4bit_CHUNK over the placeholder.
+ *
+ * A chunk overwrites a whole 8x8 area, so the placeholder leaves at least
+ * GLYPH_SPACE_WIDTH blank pixels on each side of the glyph: the chunks
+ * covering the glyph never cover the neighbouring characters.
+ */
+
+#define GLYPH_ESC          '\x1B'
+#define GLYPH_TOKEN_LEN    4
+#define GLYPH_ROWS         8    // must not exceed MATRIX_ROWS
+#define GLYPH_MAX_WIDTH    8
+#define GLYPH_SPACE_WIDTH  (0x06 + CHARSPACING)  // a blank, as drawn by the cells
+#define GLYPH_CACHE_SIZE   32   // rasterized glyphs kept by the host
+#define GLYPH_MAX_REFS     16   // glyphs in a single text window
+
+namespace FlashMat {
+
+// A glyph of the bundled font, covering the code points [first, last].
+struct GlyphBitmap
+{
+    uint32_t first;
+    uint32_t last;
+    uint8_t width;
+    uint8_t rows[GLYPH_ROWS];
+};
+
+extern const GlyphBitmap glyphFont[];
+extern const int glyphFontSize;
+
+bool glyphAvailable(long cp);
+
+/**
+ * Write the token for cp into out (GLYPH_TOKEN_LEN bytes, not terminated).
+ * Returns GLYPH_TOKEN_LEN.
+ */
+int glyphEncode(long cp, char *out);
+
+// A glyph inside an expanded text: code point and x offset in pixels.
+struct GlyphRef
+{
+    long cp;
+    int x;
+};
+
+/**
+ * Expand the first len bytes of text into out (at most outMax characters
+ * plus the terminating 0): tokens become their placeholder, and each glyph
+ * with its position is stored in refs (at most GLYPH_MAX_REFS).
+ * *width is set to the width in pixels of the first character (or
+ * placeholder) and *firstLen to its length in bytes.
+ * Returns the number of bytes of text expanded.
+ */
+int glyphExpand(const char *text, int len, char *out, int outMax,
+                GlyphRef refs[], int *nRefs, int *width, int *firstLen);
+
+// A glyph rasterized at 4 bits per color, column by column.
+struct GlyphCacheEntry
+{
+    long cp;            // -1 for an empty entry
+    uint8_t key[6];     // color and background color it was rasterized with
+    int width;
+    unsigned long used; // last use, for the LRU replacement
+    uint8_t pixels[GLYPH_MAX_WIDTH][3][GLYPH_ROWS];
+};
+
+struct GlyphCache
+{
+    GlyphCacheEntry entries[GLYPH_CACHE_SIZE];
+    unsigned long clock;
+    unsigned long hits;
+    unsigned long misses;
+};
+
+void glyphCacheInit(GlyphCache *cache);
+
+/**
+ * Return the rasterized glyph for cp, rasterizing it (and evicting the least
+ * recently used entry) on a miss. Returns NULL if the font does not have cp.
+ */
+const GlyphCacheEntry *glyphCacheGet(GlyphCache *cache, long cp,
+                                     int color[3], int bgColor[3]);
+
+/**
+ * Draw the glyphs of an expanded text, drawn by the cells at (x, y), in the
+ * back buffers of the cells (cell c is at MATRIX_COLS * c). Only the chunks
+ * the glyphs actually cover are sent. Returns the number of failed writes.
+ */
+int drawGlyphs(GlyphCache *cache, const GlyphRef refs[], int nRefs,
+               int x, int y, int fds[], int n, int color[3], int bgColor[3]);
+}
+
+#endif
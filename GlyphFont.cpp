@@ -0,0 +1,216 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Glyph.h"
+
+/*
+ * The bundled bitmap font for the characters that the cells cannot draw:
+ * some Latin-1 letters and symbols, Greek, Cyrillic (Russian) and emoji.
+ * Each row is a byte, the leftmost pixel in the most significant bit.
+ * Entries are sorted by code point; an entry can cover a whole range (e.g.
+ * the emoticons share a few faces).
+ */
+
+namespace FlashMat
+{
+
+    const GlyphBitmap glyphFont[] =
+    {
+        { 0x000A3, 0x000A3, 5, { 0x60, 0x90, 0x80, 0xE0, 0x80, 0x88, 0xF0, 0x00 } }, // pound sign
+        { 0x000A9, 0x000A9, 7, { 0x7C, 0x82, 0x9A, 0xA2, 0x9A, 0x82, 0x7C, 0x00 } }, // copyright sign
+        { 0x000AB, 0x000AB, 6, { 0x00, 0x24, 0x48, 0x90, 0x48, 0x24, 0x00, 0x00 } }, // left guillemet
+        { 0x000AE, 0x000AE, 7, { 0x7C, 0x82, 0xB2, 0xAA, 0xB2, 0xAA, 0x7C, 0x00 } }, // registered sign
+        { 0x000B0, 0x000B0, 3, { 0x40, 0xA0, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00 } }, // degree sign
+        { 0x000BB, 0x000BB, 6, { 0x00, 0x90, 0x48, 0x24, 0x48, 0x90, 0x00, 0x00 } }, // right guillemet
+        { 0x000C0, 0x000C0, 4, { 0x40, 0x20, 0x60, 0x90, 0xF0, 0x90, 0x90, 0x00 } }, // A grave
+        { 0x000C1, 0x000C1, 4, { 0x20, 0x40, 0x60, 0x90, 0xF0, 0x90, 0x90, 0x00 } }, // A acute
+        { 0x000C4, 0x000C4, 4, { 0x90, 0x00, 0x60, 0x90, 0xF0, 0x90, 0x90, 0x00 } }, // A diaeresis
+        { 0x000C7, 0x000C7, 4, { 0x60, 0x90, 0x80, 0x80, 0x80, 0x90, 0x60, 0x40 } }, // C cedilla
+        { 0x000C8, 0x000C8, 4, { 0x40, 0x20, 0xF0, 0x80, 0xE0, 0x80, 0xF0, 0x00 } }, // E grave
+        { 0x000C9, 0x000C9, 4, { 0x20, 0x40, 0xF0, 0x80, 0xE0, 0x80, 0xF0, 0x00 } }, // E acute
+        { 0x000D1, 0x000D1, 5, { 0x50, 0xA0, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x00 } }, // N tilde
+        { 0x000D6, 0x000D6, 5, { 0x88, 0x00, 0x70, 0x88, 0x88, 0x88, 0x70, 0x00 } }, // O diaeresis
+        { 0x000DC, 0x000DC, 5, { 0x88, 0x00, 0x88, 0x88, 0x88, 0x88, 0x70, 0x00 } }, // U diaeresis
+        { 0x000DF, 0x000DF, 4, { 0x60, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0xA0, 0x00 } }, // sharp s
+        { 0x000E1, 0x000E1, 4, { 0x20, 0x40, 0x00, 0x70, 0x90, 0x90, 0x70, 0x00 } }, // a acute
+        { 0x000E4, 0x000E4, 4, { 0x00, 0x90, 0x00, 0x70, 0x90, 0x90, 0x70, 0x00 } }, // a diaeresis
+        { 0x000E7, 0x000E7, 3, { 0x00, 0x00, 0x00, 0x60, 0x80, 0x80, 0x60, 0x40 } }, // c cedilla
+        { 0x000E9, 0x000E9, 4, { 0x20, 0x40, 0x00, 0x60, 0xF0, 0x80, 0x70, 0x00 } }, // e acute
+        { 0x000ED, 0x000ED, 2, { 0x40, 0x80, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00 } }, // i acute
+        { 0x000F1, 0x000F1, 4, { 0x50, 0xA0, 0x00, 0xE0, 0x90, 0x90, 0x90, 0x00 } }, // n tilde
+        { 0x000F3, 0x000F3, 4, { 0x20, 0x40, 0x00, 0x60, 0x90, 0x90, 0x60, 0x00 } }, // o acute
+        { 0x000F6, 0x000F6, 4, { 0x00, 0x90, 0x00, 0x60, 0x90, 0x90, 0x60, 0x00 } }, // o diaeresis
+        { 0x000FA, 0x000FA, 4, { 0x20, 0x40, 0x00, 0x90, 0x90, 0x90, 0x70, 0x00 } }, // u acute
+        { 0x000FC, 0x000FC, 4, { 0x00, 0x90, 0x00, 0x90, 0x90, 0x90, 0x70, 0x00 } }, // u diaeresis
+        { 0x00386, 0x00386, 4, { 0x60, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x90, 0x00 } }, // Greek capital alpha with tonos
+        { 0x00388, 0x00388, 4, { 0xF0, 0x80, 0x80, 0xE0, 0x80, 0x80, 0xF0, 0x00 } }, // Greek capital epsilon with tonos
+        { 0x00389, 0x00389, 4, { 0x90, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x90, 0x00 } }, // Greek capital eta with tonos
+        { 0x0038A, 0x0038A, 3, { 0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x00 } }, // Greek capital iota with tonos
+        { 0x0038C, 0x0038C, 4, { 0x60, 0x90, 0x90, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Greek capital omicron with tonos
+        { 0x0038E, 0x0038E, 5, { 0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x20, 0x00 } }, // Greek capital upsilon with tonos
+        { 0x00391, 0x00391, 4, { 0x60, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x90, 0x00 } }, // Greek capital alpha
+        { 0x00392, 0x00392, 4, { 0xE0, 0x90, 0x90, 0xE0, 0x90, 0x90, 0xE0, 0x00 } }, // Greek capital beta
+        { 0x00393, 0x00393, 4, { 0xF0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 } }, // Greek capital gamma
+        { 0x00394, 0x00394, 5, { 0x00, 0x20, 0x50, 0x50, 0x88, 0x88, 0xF8, 0x00 } }, // Greek capital delta
+        { 0x00395, 0x00395, 4, { 0xF0, 0x80, 0x80, 0xE0, 0x80, 0x80, 0xF0, 0x00 } }, // Greek capital epsilon
+        { 0x00396, 0x00396, 4, { 0xF0, 0x10, 0x20, 0x40, 0x80, 0x80, 0xF0, 0x00 } }, // Greek capital zeta
+        { 0x00397, 0x00397, 4, { 0x90, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x90, 0x00 } }, // Greek capital eta
+        { 0x00398, 0x00398, 4, { 0x60, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x60, 0x00 } }, // Greek capital theta
+        { 0x00399, 0x00399, 3, { 0xE0, 0x40, 0x40, 0x40, 0x40, 0x40, 0xE0, 0x00 } }, // Greek capital iota
+        { 0x0039A, 0x0039A, 4, { 0x90, 0xA0, 0xC0, 0x80, 0xC0, 0xA0, 0x90, 0x00 } }, // Greek capital kappa
+        { 0x0039B, 0x0039B, 5, { 0x20, 0x50, 0x50, 0x88, 0x88, 0x88, 0x88, 0x00 } }, // Greek capital lamda
+        { 0x0039C, 0x0039C, 5, { 0x88, 0xD8, 0xA8, 0x88, 0x88, 0x88, 0x88, 0x00 } }, // Greek capital mu
+        { 0x0039D, 0x0039D, 5, { 0x88, 0x88, 0xC8, 0xA8, 0x98, 0x88, 0x88, 0x00 } }, // Greek capital nu
+        { 0x0039E, 0x0039E, 4, { 0xF0, 0x00, 0x00, 0x60, 0x00, 0x00, 0xF0, 0x00 } }, // Greek capital xi
+        { 0x0039F, 0x0039F, 4, { 0x60, 0x90, 0x90, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Greek capital omicron
+        { 0x003A0, 0x003A0, 4, { 0xF0, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x00 } }, // Greek capital pi
+        { 0x003A1, 0x003A1, 4, { 0xE0, 0x90, 0x90, 0xE0, 0x80, 0x80, 0x80, 0x00 } }, // Greek capital rho
+        { 0x003A3, 0x003A3, 4, { 0xF0, 0x80, 0x40, 0x20, 0x40, 0x80, 0xF0, 0x00 } }, // Greek capital sigma
+        { 0x003A4, 0x003A4, 5, { 0xF8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00 } }, // Greek capital tau
+        { 0x003A5, 0x003A5, 5, { 0x88, 0x88, 0x50, 0x20, 0x20, 0x20, 0x20, 0x00 } }, // Greek capital upsilon
+        { 0x003A6, 0x003A6, 5, { 0x20, 0x70, 0xA8, 0xA8, 0xA8, 0x70, 0x20, 0x00 } }, // Greek capital phi
+        { 0x003A7, 0x003A7, 5, { 0x88, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x00 } }, // Greek capital chi
+        { 0x003A8, 0x003A8, 5, { 0xA8, 0xA8, 0xA8, 0x70, 0x20, 0x20, 0x20, 0x00 } }, // Greek capital psi
+        { 0x003A9, 0x003A9, 5, { 0x70, 0x88, 0x88, 0x88, 0x50, 0x50, 0xD8, 0x00 } }, // Greek capital omega
+        { 0x003AC, 0x003AC, 5, { 0x20, 0x40, 0x68, 0x90, 0x90, 0x90, 0x68, 0x00 } }, // Greek small alpha with tonos
+        { 0x003AD, 0x003AD, 4, { 0x20, 0x40, 0x70, 0x80, 0x60, 0x80, 0x70, 0x00 } }, // Greek small epsilon with tonos
+        { 0x003AE, 0x003AE, 4, { 0x20, 0x40, 0xE0, 0x90, 0x90, 0x90, 0x90, 0x10 } }, // Greek small eta with tonos
+        { 0x003AF, 0x003AF, 2, { 0x40, 0x80, 0x80, 0x80, 0x80, 0x80, 0x40, 0x00 } }, // Greek small iota with tonos
+        { 0x003B1, 0x003B1, 5, { 0x00, 0x00, 0x68, 0x90, 0x90, 0x90, 0x68, 0x00 } }, // Greek small alpha
+        { 0x003B2, 0x003B2, 4, { 0x60, 0x90, 0xE0, 0x90, 0x90, 0xE0, 0x80, 0x80 } }, // Greek small beta
+        { 0x003B3, 0x003B3, 4, { 0x00, 0x00, 0x90, 0x90, 0x60, 0x60, 0x40, 0x40 } }, // Greek small gamma
+        { 0x003B4, 0x003B4, 4, { 0x60, 0x80, 0x40, 0x60, 0x90, 0x90, 0x60, 0x00 } }, // Greek small delta
+        { 0x003B5, 0x003B5, 4, { 0x00, 0x00, 0x70, 0x80, 0x60, 0x80, 0x70, 0x00 } }, // Greek small epsilon
+        { 0x003B6, 0x003B6, 4, { 0xF0, 0x20, 0x40, 0x80, 0x80, 0x60, 0x10, 0x20 } }, // Greek small zeta
+        { 0x003B7, 0x003B7, 4, { 0x00, 0x00, 0xE0, 0x90, 0x90, 0x90, 0x90, 0x10 } }, // Greek small eta
+        { 0x003B8, 0x003B8, 4, { 0x60, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x60, 0x00 } }, // Greek small theta
+        { 0x003B9, 0x003B9, 2, { 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x40, 0x00 } }, // Greek small iota
+        { 0x003BA, 0x003BA, 4, { 0x00, 0x00, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x00 } }, // Greek small kappa
+        { 0x003BB, 0x003BB, 4, { 0x80, 0x40, 0x40, 0x60, 0x90, 0x90, 0x90, 0x00 } }, // Greek small lamda
+        { 0x003BC, 0x003BC, 4, { 0x00, 0x00, 0x90, 0x90, 0x90, 0xE0, 0x80, 0x80 } }, // Greek small mu
+        { 0x003BD, 0x003BD, 4, { 0x00, 0x00, 0x90, 0x90, 0x90, 0x60, 0x60, 0x00 } }, // Greek small nu
+        { 0x003BE, 0x003BE, 4, { 0xF0, 0x80, 0x70, 0x80, 0x80, 0x60, 0x10, 0x20 } }, // Greek small xi
+        { 0x003BF, 0x003BF, 4, { 0x00, 0x00, 0x60, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Greek small omicron
+        { 0x003C0, 0x003C0, 5, { 0x00, 0x00, 0xF8, 0x50, 0x50, 0x50, 0x50, 0x00 } }, // Greek small pi
+        { 0x003C1, 0x003C1, 4, { 0x00, 0x00, 0x60, 0x90, 0x90, 0xE0, 0x80, 0x80 } }, // Greek small rho
+        { 0x003C2, 0x003C2, 4, { 0x00, 0x00, 0x70, 0x80, 0x80, 0x60, 0x10, 0x20 } }, // Greek small final sigma
+        { 0x003C3, 0x003C3, 5, { 0x00, 0x00, 0x78, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Greek small sigma
+        { 0x003C4, 0x003C4, 4, { 0x00, 0x00, 0xF0, 0x40, 0x40, 0x40, 0x20, 0x00 } }, // Greek small tau
+        { 0x003C5, 0x003C5, 4, { 0x00, 0x00, 0x90, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Greek small upsilon
+        { 0x003C6, 0x003C6, 5, { 0x00, 0x20, 0x70, 0xA8, 0xA8, 0xA8, 0x70, 0x20 } }, // Greek small phi
+        { 0x003C7, 0x003C7, 4, { 0x00, 0x00, 0x90, 0x90, 0x60, 0x60, 0x90, 0x90 } }, // Greek small chi
+        { 0x003C8, 0x003C8, 5, { 0x00, 0x00, 0xA8, 0xA8, 0xA8, 0x70, 0x20, 0x20 } }, // Greek small psi
+        { 0x003C9, 0x003C9, 5, { 0x00, 0x00, 0x50, 0x88, 0xA8, 0xA8, 0x50, 0x00 } }, // Greek small omega
+        { 0x003CA, 0x003CA, 2, { 0xC0, 0x00, 0x80, 0x80, 0x80, 0x80, 0x40, 0x00 } }, // Greek small iota with dialytika
+        { 0x003CB, 0x003CB, 4, { 0x90, 0x00, 0x90, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Greek small upsilon with dialytika
+        { 0x003CC, 0x003CC, 4, { 0x20, 0x40, 0x60, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Greek small omicron with tonos
+        { 0x003CD, 0x003CD, 4, { 0x20, 0x40, 0x90, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Greek small upsilon with tonos
+        { 0x003CE, 0x003CE, 5, { 0x20, 0x40, 0x50, 0x88, 0xA8, 0xA8, 0x50, 0x00 } }, // Greek small omega with tonos
+        { 0x00401, 0x00401, 4, { 0x90, 0x00, 0xF0, 0x80, 0xE0, 0x80, 0xF0, 0x00 } }, // Cyrillic capital io
+        { 0x00410, 0x00410, 4, { 0x60, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x90, 0x00 } }, // Cyrillic capital a
+        { 0x00411, 0x00411, 4, { 0xF0, 0x80, 0x80, 0xE0, 0x90, 0x90, 0xE0, 0x00 } }, // Cyrillic capital be
+        { 0x00412, 0x00412, 4, { 0xE0, 0x90, 0x90, 0xE0, 0x90, 0x90, 0xE0, 0x00 } }, // Cyrillic capital ve
+        { 0x00413, 0x00413, 4, { 0xF0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 } }, // Cyrillic capital ghe
+        { 0x00414, 0x00414, 5, { 0x70, 0x50, 0x50, 0x50, 0x50, 0xF8, 0x88, 0x00 } }, // Cyrillic capital de
+        { 0x00415, 0x00415, 4, { 0xF0, 0x80, 0x80, 0xE0, 0x80, 0x80, 0xF0, 0x00 } }, // Cyrillic capital ie
+        { 0x00416, 0x00416, 5, { 0xA8, 0xA8, 0x70, 0x20, 0x70, 0xA8, 0xA8, 0x00 } }, // Cyrillic capital zhe
+        { 0x00417, 0x00417, 4, { 0x60, 0x90, 0x10, 0x60, 0x10, 0x90, 0x60, 0x00 } }, // Cyrillic capital ze
+        { 0x00418, 0x00418, 5, { 0x88, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x88, 0x00 } }, // Cyrillic capital i
+        { 0x00419, 0x00419, 5, { 0x50, 0x20, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x00 } }, // Cyrillic capital short i
+        { 0x0041A, 0x0041A, 4, { 0x90, 0xA0, 0xC0, 0x80, 0xC0, 0xA0, 0x90, 0x00 } }, // Cyrillic capital ka
+        { 0x0041B, 0x0041B, 5, { 0x38, 0x48, 0x48, 0x48, 0x48, 0x88, 0x88, 0x00 } }, // Cyrillic capital el
+        { 0x0041C, 0x0041C, 5, { 0x88, 0xD8, 0xA8, 0x88, 0x88, 0x88, 0x88, 0x00 } }, // Cyrillic capital em
+        { 0x0041D, 0x0041D, 4, { 0x90, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x90, 0x00 } }, // Cyrillic capital en
+        { 0x0041E, 0x0041E, 4, { 0x60, 0x90, 0x90, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Cyrillic capital o
+        { 0x0041F, 0x0041F, 4, { 0xF0, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x00 } }, // Cyrillic capital pe
+        { 0x00420, 0x00420, 4, { 0xE0, 0x90, 0x90, 0xE0, 0x80, 0x80, 0x80, 0x00 } }, // Cyrillic capital er
+        { 0x00421, 0x00421, 4, { 0x60, 0x90, 0x80, 0x80, 0x80, 0x90, 0x60, 0x00 } }, // Cyrillic capital es
+        { 0x00422, 0x00422, 5, { 0xF8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00 } }, // Cyrillic capital te
+        { 0x00423, 0x00423, 4, { 0x90, 0x90, 0x90, 0x70, 0x10, 0x90, 0x60, 0x00 } }, // Cyrillic capital u
+        { 0x00424, 0x00424, 5, { 0x20, 0x70, 0xA8, 0xA8, 0xA8, 0x70, 0x20, 0x00 } }, // Cyrillic capital ef
+        { 0x00425, 0x00425, 5, { 0x88, 0x88, 0x50, 0x20, 0x50, 0x88, 0x88, 0x00 } }, // Cyrillic capital ha
+        { 0x00426, 0x00426, 5, { 0x90, 0x90, 0x90, 0x90, 0x90, 0xF8, 0x08, 0x00 } }, // Cyrillic capital tse
+        { 0x00427, 0x00427, 4, { 0x90, 0x90, 0x90, 0x70, 0x10, 0x10, 0x10, 0x00 } }, // Cyrillic capital che
+        { 0x00428, 0x00428, 5, { 0x88, 0x88, 0xA8, 0xA8, 0xA8, 0xA8, 0xF8, 0x00 } }, // Cyrillic capital sha
+        { 0x00429, 0x00429, 6, { 0xA8, 0xA8, 0xA8, 0xA8, 0xA8, 0xFC, 0x04, 0x00 } }, // Cyrillic capital shcha
+        { 0x0042A, 0x0042A, 5, { 0xC0, 0x40, 0x40, 0x70, 0x48, 0x48, 0x70, 0x00 } }, // Cyrillic capital hard sign
+        { 0x0042B, 0x0042B, 5, { 0x88, 0x88, 0x88, 0xE8, 0x98, 0x98, 0xE8, 0x00 } }, // Cyrillic capital yeru
+        { 0x0042C, 0x0042C, 4, { 0x80, 0x80, 0x80, 0xE0, 0x90, 0x90, 0xE0, 0x00 } }, // Cyrillic capital soft sign
+        { 0x0042D, 0x0042D, 4, { 0x60, 0x90, 0x10, 0x70, 0x10, 0x90, 0x60, 0x00 } }, // Cyrillic capital e
+        { 0x0042E, 0x0042E, 6, { 0x98, 0xA4, 0xA4, 0xE4, 0xA4, 0xA4, 0x98, 0x00 } }, // Cyrillic capital yu
+        { 0x0042F, 0x0042F, 4, { 0x70, 0x90, 0x90, 0x70, 0x50, 0x90, 0x90, 0x00 } }, // Cyrillic capital ya
+        { 0x00430, 0x00430, 4, { 0x00, 0x00, 0x60, 0x10, 0x70, 0x90, 0x70, 0x00 } }, // Cyrillic small a
+        { 0x00431, 0x00431, 4, { 0x00, 0x70, 0x80, 0xE0, 0x90, 0x90, 0x60, 0x00 } }, // Cyrillic small be
+        { 0x00432, 0x00432, 4, { 0x00, 0x00, 0xE0, 0x90, 0xE0, 0x90, 0xE0, 0x00 } }, // Cyrillic small ve
+        { 0x00433, 0x00433, 4, { 0x00, 0x00, 0xF0, 0x80, 0x80, 0x80, 0x80, 0x00 } }, // Cyrillic small ghe
+        { 0x00434, 0x00434, 5, { 0x00, 0x00, 0x70, 0x50, 0x50, 0xF8, 0x88, 0x00 } }, // Cyrillic small de
+        { 0x00435, 0x00435, 4, { 0x00, 0x00, 0x60, 0x90, 0xF0, 0x80, 0x70, 0x00 } }, // Cyrillic small ie
+        { 0x00436, 0x00436, 5, { 0x00, 0x00, 0xA8, 0x70, 0x20, 0x70, 0xA8, 0x00 } }, // Cyrillic small zhe
+        { 0x00437, 0x00437, 4, { 0x00, 0x00, 0xE0, 0x10, 0x60, 0x10, 0xE0, 0x00 } }, // Cyrillic small ze
+        { 0x00438, 0x00438, 4, { 0x00, 0x00, 0x90, 0x90, 0xB0, 0xD0, 0x90, 0x00 } }, // Cyrillic small i
+        { 0x00439, 0x00439, 4, { 0x90, 0x60, 0x90, 0x90, 0xB0, 0xD0, 0x90, 0x00 } }, // Cyrillic small short i
+        { 0x0043A, 0x0043A, 4, { 0x00, 0x00, 0x90, 0xA0, 0xC0, 0xA0, 0x90, 0x00 } }, // Cyrillic small ka
+        { 0x0043B, 0x0043B, 4, { 0x00, 0x00, 0x30, 0x50, 0x50, 0x50, 0x90, 0x00 } }, // Cyrillic small el
+        { 0x0043C, 0x0043C, 5, { 0x00, 0x00, 0x88, 0xD8, 0xA8, 0x88, 0x88, 0x00 } }, // Cyrillic small em
+        { 0x0043D, 0x0043D, 4, { 0x00, 0x00, 0x90, 0x90, 0xF0, 0x90, 0x90, 0x00 } }, // Cyrillic small en
+        { 0x0043E, 0x0043E, 4, { 0x00, 0x00, 0x60, 0x90, 0x90, 0x90, 0x60, 0x00 } }, // Cyrillic small o
+        { 0x0043F, 0x0043F, 4, { 0x00, 0x00, 0xF0, 0x90, 0x90, 0x90, 0x90, 0x00 } }, // Cyrillic small pe
+        { 0x00440, 0x00440, 4, { 0x00, 0x00, 0xE0, 0x90, 0x90, 0xE0, 0x80, 0x80 } }, // Cyrillic small er
+        { 0x00441, 0x00441, 4, { 0x00, 0x00, 0x70, 0x80, 0x80, 0x80, 0x70, 0x00 } }, // Cyrillic small es
+        { 0x00442, 0x00442, 5, { 0x00, 0x00, 0xF8, 0x20, 0x20, 0x20, 0x20, 0x00 } }, // Cyrillic small te
+        { 0x00443, 0x00443, 4, { 0x00, 0x00, 0x90, 0x90, 0x90, 0x70, 0x10, 0x60 } }, // Cyrillic small u
+        { 0x00444, 0x00444, 5, { 0x00, 0x20, 0x70, 0xA8, 0xA8, 0xA8, 0x70, 0x20 } }, // Cyrillic small ef
+        { 0x00445, 0x00445, 4, { 0x00, 0x00, 0x90, 0x90, 0x60, 0x90, 0x90, 0x00 } }, // Cyrillic small ha
+        { 0x00446, 0x00446, 5, { 0x00, 0x00, 0x90, 0x90, 0x90, 0x90, 0xF8, 0x08 } }, // Cyrillic small tse
+        { 0x00447, 0x00447, 4, { 0x00, 0x00, 0x90, 0x90, 0x70, 0x10, 0x10, 0x00 } }, // Cyrillic small che
+        { 0x00448, 0x00448, 5, { 0x00, 0x00, 0x88, 0xA8, 0xA8, 0xA8, 0xF8, 0x00 } }, // Cyrillic small sha
+        { 0x00449, 0x00449, 6, { 0x00, 0x00, 0xA8, 0xA8, 0xA8, 0xA8, 0xFC, 0x04 } }, // Cyrillic small shcha
+        { 0x0044A, 0x0044A, 5, { 0x00, 0x00, 0xC0, 0x40, 0x70, 0x48, 0x70, 0x00 } }, // Cyrillic small hard sign
+        { 0x0044B, 0x0044B, 5, { 0x00, 0x00, 0x88, 0x88, 0xE8, 0x98, 0xE8, 0x00 } }, // Cyrillic small yeru
+        { 0x0044C, 0x0044C, 4, { 0x00, 0x00, 0x80, 0x80, 0xE0, 0x90, 0xE0, 0x00 } }, // Cyrillic small soft sign
+        { 0x0044D, 0x0044D, 4, { 0x00, 0x00, 0xE0, 0x10, 0x70, 0x10, 0xE0, 0x00 } }, // Cyrillic small e
+        { 0x0044E, 0x0044E, 6, { 0x00, 0x00, 0x98, 0xA4, 0xE4, 0xA4, 0x98, 0x00 } }, // Cyrillic small yu
+        { 0x0044F, 0x0044F, 4, { 0x00, 0x00, 0x70, 0x90, 0x70, 0x50, 0x90, 0x00 } }, // Cyrillic small ya
+        { 0x00451, 0x00451, 4, { 0x90, 0x00, 0x60, 0x90, 0xF0, 0x80, 0x70, 0x00 } }, // Cyrillic small io
+        { 0x020AC, 0x020AC, 5, { 0x38, 0x40, 0xF0, 0x40, 0xF0, 0x40, 0x38, 0x00 } }, // euro sign
+        { 0x02122, 0x02122, 8, { 0xEA, 0x55, 0x51, 0x40, 0x00, 0x00, 0x00, 0x00 } }, // trade mark sign
+        { 0x02190, 0x02190, 7, { 0x00, 0x20, 0x40, 0xFE, 0x40, 0x20, 0x00, 0x00 } }, // leftwards arrow
+        { 0x02191, 0x02191, 5, { 0x20, 0x70, 0xA8, 0x20, 0x20, 0x20, 0x20, 0x00 } }, // upwards arrow
+        { 0x02192, 0x02192, 7, { 0x00, 0x08, 0x04, 0xFE, 0x04, 0x08, 0x00, 0x00 } }, // rightwards arrow
+        { 0x02193, 0x02193, 5, { 0x20, 0x20, 0x20, 0x20, 0xA8, 0x70, 0x20, 0x00 } }, // downwards arrow
+        { 0x02605, 0x02605, 7, { 0x10, 0x10, 0xFE, 0x7C, 0x38, 0x6C, 0x82, 0x00 } }, // black star
+        { 0x02606, 0x02606, 7, { 0x10, 0x28, 0xEE, 0x44, 0x28, 0x54, 0x82, 0x00 } }, // white star
+        { 0x02639, 0x02639, 7, { 0x7C, 0x82, 0xAA, 0x82, 0x92, 0xAA, 0x7C, 0x00 } }, // frowning face
+        { 0x0263A, 0x0263B, 7, { 0x7C, 0x82, 0xAA, 0x82, 0xAA, 0x92, 0x7C, 0x00 } }, // smiling face
+        { 0x02665, 0x02665, 7, { 0x00, 0x6C, 0xFE, 0xFE, 0x7C, 0x38, 0x10, 0x00 } }, // black heart suit
+        { 0x0266A, 0x0266A, 5, { 0x20, 0x30, 0x28, 0x20, 0x60, 0xE0, 0x40, 0x00 } }, // eighth note
+        { 0x02713, 0x02714, 7, { 0x02, 0x04, 0x08, 0x90, 0x60, 0x40, 0x00, 0x00 } }, // check mark
+        { 0x02764, 0x02764, 7, { 0x00, 0x6C, 0xFE, 0xFE, 0x7C, 0x38, 0x10, 0x00 } }, // heavy black heart
+        { 0x1F389, 0x1F389, 7, { 0x4A, 0x10, 0x9A, 0x38, 0x78, 0xF8, 0xE0, 0x00 } }, // party popper
+        { 0x1F44D, 0x1F44D, 6, { 0x10, 0x30, 0x30, 0xF8, 0xBC, 0xB8, 0xBC, 0x78 } }, // thumbs up sign
+        { 0x1F493, 0x1F49F, 7, { 0x00, 0x6C, 0xFE, 0xFE, 0x7C, 0x38, 0x10, 0x00 } }, // hearts
+        { 0x1F525, 0x1F525, 6, { 0x10, 0x30, 0x34, 0x5C, 0x6C, 0xA4, 0x84, 0x78 } }, // fire
+        { 0x1F600, 0x1F60F, 7, { 0x7C, 0x82, 0xAA, 0x82, 0xAA, 0x92, 0x7C, 0x00 } }, // smiling faces
+        { 0x1F610, 0x1F613, 7, { 0x7C, 0x82, 0xAA, 0x82, 0xBA, 0x82, 0x7C, 0x00 } }, // neutral faces
+        { 0x1F614, 0x1F62D, 7, { 0x7C, 0x82, 0xAA, 0x82, 0x92, 0xAA, 0x7C, 0x00 } }, // sad faces
+    };
+
+    const int glyphFontSize = sizeof(glyphFont) / sizeof(glyphFont[0]);
+
+}
@@ -0,0 +1,124 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <wiringPi.h>
+
+#include "Health.h"
+#include "PiCommander.h"
+
+
+namespace FlashMat
+{
+
+    static CellHealth cells[CELLS];
+    static int cellCount = 0;
+
+    static CellHealth *find(int fd)
+    {
+        for(int c = 0; c < cellCount; c++)
+            if(cells[c].fd == fd)
+                return &cells[c];
+        return NULL;
+    }
+
+    static bool allow(int fd)
+    {
+        CellHealth *cell = find(fd);
+        return cell == NULL || !cell->down || cell->probing;
+    }
+
+    static void done(int fd, int result)
+    {
+        CellHealth *cell = find(fd);
+        if(cell == NULL || result >= 0 || cell->down)
+            return;
+        cell->errors++;
+        cell->down = true;
+        cell->backoff = HEALTH_MIN_BACKOFF;
+        cell->retryAt = millis() + cell->backoff;
+        fprintf(stderr, "cell 0x%02X: write failed, cell down\n", cell->address);
+    }
+
+    static const WriteGate gate = { allow, done };
+
+    void healthInit(const int fds[], const int addresses[], int n)
+    {
+        memset(cells, 0, sizeof(cells));
+        cellCount = n < CELLS ? n : CELLS;
+        for(int c = 0; c < cellCount; c++)
+        {
+            cells[c].fd = fds[c];
+            cells[c].address = addresses[c];
+        }
+        setWriteGate(&gate);
+    }
+
+    int healthPoll(unsigned int now, int recovered[])
+    {
+        int n = 0;
+        for(int c = 0; c < cellCount; c++)
+        {
+            CellHealth *cell = &cells[c];
+            // Wrap-around safe comparison of millis() values.
+            if(!cell->down || (int)(now - cell->retryAt) < 0)
+                continue;
+            cell->probing = true;
+            int res = sendPing(cell->fd);
+            cell->probing = false;
+            if(res < 0)
+            {
+                cell->errors++;
+                cell->backoff *= 2;
+                if(cell->backoff > HEALTH_MAX_BACKOFF)
+                    cell->backoff = HEALTH_MAX_BACKOFF;
+                cell->retryAt = now + cell->backoff;
+                continue;
+            }
+            cell->down = false;
+            cell->resets++;
+            recovered[n++] = c;
+            fprintf(stderr, "cell 0x%02X: back, initializing it again\n",
+                    cell->address);
+        }
+        return n;
+    }
+
+    bool healthNextRetry(unsigned int *at)
+    {
+        bool found = false;
+        for(int c = 0; c < cellCount; c++)
+            if(cells[c].down && (!found || (int)(cells[c].retryAt - *at) < 0))
+            {
+                *at = cells[c].retryAt;
+                found = true;
+            }
+        return found;
+    }
+
+    void healthReport(FILE *out)
+    {
+        for(int c = 0; c < cellCount; c++)
+            fprintf(out, "cell 0x%02X: %s, %lu errors, %lu resets\n",
+                    cells[c].address, cells[c].down ? "down" : "up",
+                    cells[c].errors, cells[c].resets);
+    }
+
+}
@@ -0,0 +1,74 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HEALTH_H_
+#define HEALTH_H_
+
+#include <stdio.h>
+
+#include "Settings.h"
+
+#define HEALTH_MIN_BACKOFF     50   // ms before the first PING to a failing cell
+#define HEALTH_MAX_BACKOFF  10000   // ms, the backoff doubles up to this
+
+namespace FlashMat {
+
+/**
+ * Health of each cell, tracked from the result of every write (through the
+ * WriteGate of PiCommander.h).
+ *
+ * When a write to a cell fails, the cell is considered down: every further
+ * write to it is skipped (at no cost for the bus) and the cell is probed
+ * with a PING after an exponential backoff. A down cell that answers the
+ * PING has been reset (or reconnected), so it has lost everything we sent:
+ * it is reported by healthPoll() to be initialized again.
+ */
+struct CellHealth
+{
+    int fd;
+    int address;
+    bool down;
+    bool probing;           // the write being done is the PING
+    unsigned int retryAt;   // millis() of the next PING
+    unsigned int backoff;   // ms
+    unsigned long errors;   // failed writes
+    unsigned long resets;   // times the cell came back
+};
+
+/**
+ * Start tracking the given cells and install the write gate.
+ */
+void healthInit(const int fds[], const int addresses[], int n);
+
+/**
+ * PING the down cells whose backoff has expired. The indexes of the cells
+ * that are back (and must be initialized again) are stored in recovered.
+ * Returns the number of such cells.
+ */
+int healthPoll(unsigned int now, int recovered[]);
+
+/**
+ * When the next PING is due (millis()); false if no cell is down.
+ */
+bool healthNextRetry(unsigned int *at);
+
+void healthReport(FILE *out);
+}
+
+#endif
@@ -0,0 +1,202 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "Packer.h"
+#include "PiCommander.h"
+
+// Build with -DPACK_SCALAR to compare the vector kernels with the reference.
+#if defined(PACK_SCALAR)
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PACK_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define PACK_SSE2
+#include <emmintrin.h>
+#endif
+
+#if COLOR_DEPTH != 4
+#error "Packer.cpp only handles COLOR_DEPTH 4"
+#endif
+
+
+namespace FlashMat
+{
+
+    // 4x4 Bayer matrix: added to a color before dropping its low 4 bits, it
+    // rounds up in proportion to them.
+    static const uint8_t bayer[4][4] =
+    {
+        {  0,  8,  2, 10 },
+        { 12,  4, 14,  6 },
+        {  3, 11,  1,  9 },
+        { 15,  7, 13,  5 }
+    };
+
+    // The plane of each color of the input (R, G, B), as in MAKE_RGB.
+    static const int planeOf[3] = { R, G, B };
+
+    /*
+     * All kernels quantise a row of width pixels and pack it, 2 pixels per
+     * byte (left one in the high nibble), into the 3 planes of out.
+     * dither holds the thresholds of pixels 0-15 (the pattern repeats every
+     * 4 pixels, and width is a multiple of 8).
+     */
+
+    static void packRowScalar(const uint8_t *rgb, int x, int width,
+                              const uint8_t dither[16],
+                              uint8_t out[3][MATRIX_ROW_SIZE])
+    {
+        for(; x < width; x += 2)
+        {
+            for(int ch = 0; ch < 3; ch++)
+            {
+                int left = rgb[3 * x + ch] + dither[x & 15];
+                int right = rgb[3 * x + 3 + ch] + dither[(x + 1) & 15];
+                if(left > 0xFF)
+                    left = 0xFF;
+                if(right > 0xFF)
+                    right = 0xFF;
+                out[planeOf[ch]][x / 2] = (left & 0xF0) | (right >> 4);
+            }
+        }
+    }
+
+#if defined(PACK_NEON)
+    static void packRow(const uint8_t *rgb, int width, const uint8_t dither[16],
+                        uint8_t out[3][MATRIX_ROW_SIZE])
+    {
+        const uint8x16_t threshold = vld1q_u8(dither);
+        const uint16x8_t high = vdupq_n_u16(0x00F0);
+        int x = 0;
+        for(; x + 16 <= width; x += 16)
+        {
+            uint8x16x3_t px = vld3q_u8(rgb + 3 * x);
+            for(int ch = 0; ch < 3; ch++)
+            {
+                // In each 16-bit lane, the left pixel is the low byte.
+                uint16x8_t pair = vreinterpretq_u16_u8(
+                        vqaddq_u8(px.val[ch], threshold));
+                uint16x8_t packed = vorrq_u16(vandq_u16(pair, high),
+                                              vshrq_n_u16(pair, 12));
+                vst1_u8(out[planeOf[ch]] + x / 2, vmovn_u16(packed));
+            }
+        }
+        packRowScalar(rgb, x, width, dither, out);
+    }
+
+    const char *packKernel()
+    {
+        return "neon";
+    }
+#elif defined(PACK_SSE2)
+    static inline __m128i packPairs(__m128i color, __m128i threshold)
+    {
+        // In each 16-bit lane, the left pixel is the low byte.
+        __m128i pair = _mm_adds_epu8(color, threshold);
+        return _mm_or_si128(_mm_and_si128(pair, _mm_set1_epi16(0x00F0)),
+                            _mm_srli_epi16(pair, 12));
+    }
+
+    static void packRow(const uint8_t *rgb, int width, const uint8_t dither[16],
+                        uint8_t out[3][MATRIX_ROW_SIZE])
+    {
+        const __m128i threshold = _mm_loadu_si128((const __m128i *)dither);
+        int x = 0;
+        for(; x + 32 <= width; x += 32)
+        {
+            __m128i v[6], t[6];
+            for(int i = 0; i < 6; i++)
+                v[i] = _mm_loadu_si128((const __m128i *)(rgb + 3 * x + 16 * i));
+            // SSE2 has no 3-way deinterleave: 5 rounds of byte interleaving
+            // turn the 32 RGB pixels into R R G G B B (16 pixels each).
+            for(int round = 0; round < 5; round++)
+            {
+                for(int i = 0; i < 3; i++)
+                {
+                    t[2 * i] = _mm_unpacklo_epi8(v[i], v[i + 3]);
+                    t[2 * i + 1] = _mm_unpackhi_epi8(v[i], v[i + 3]);
+                }
+                memcpy(v, t, sizeof(v));
+            }
+            for(int ch = 0; ch < 3; ch++)
+                _mm_storeu_si128((__m128i *)(out[planeOf[ch]] + x / 2),
+                                 _mm_packus_epi16(packPairs(v[2 * ch], threshold),
+                                                  packPairs(v[2 * ch + 1], threshold)));
+        }
+        packRowScalar(rgb, x, width, dither, out);
+    }
+
+    const char *packKernel()
+    {
+        return "sse2";
+    }
+#else
+    static void packRow(const uint8_t *rgb, int width, const uint8_t dither[16],
+                        uint8_t out[3][MATRIX_ROW_SIZE])
+    {
+        packRowScalar(rgb, 0, width, dither, out);
+    }
+
+    const char *packKernel()
+    {
+        return "scalar";
+    }
+#endif
+
+    void packFrame(const uint8_t *rgb, int stride, int n, bool dither,
+                   uint8_t chunks[][SIZE_8x8])
+    {
+        uint8_t row[3][MATRIX_ROW_SIZE];
+        uint8_t threshold[16];
+        memset(threshold, 0, sizeof(threshold));
+        for(int y = 0; y < MATRIX_ROWS; y++)
+        {
+            if(dither)
+                for(int x = 0; x < 16; x++)
+                    threshold[x] = bayer[y & 3][x & 3];
+            for(int c = 0; c < n; c++)
+            {
+                packRow(rgb + y * stride + c * MATRIX_COLS * 3, MATRIX_COLS,
+                        threshold, row);
+                uint8_t (*cell)[SIZE_8x8] = chunks + c * CELL_CHUNKS
+                                            + (y / 8) * (MATRIX_COLS / 8);
+                for(int col = 0; col < MATRIX_COLS / 8; col++)
+                    for(int p = 0; p < 3; p++)
+                        memcpy(cell[col] + p * CHUNK_PLANE_SIZE
+                                   + (y % 8) * CHUNK_ROW_SIZE,
+                               row[p] + col * CHUNK_ROW_SIZE, CHUNK_ROW_SIZE);
+            }
+        }
+    }
+
+    int sendPackedFrame(int fds[], int n, const uint8_t chunks[][SIZE_8x8])
+    {
+        int errors = 0;
+        for(int c = 0; c < n; c++)
+            for(int row = 0; row < MATRIX_ROWS / 8; row++)
+                for(int col = 0; col < MATRIX_COLS / 8; col++)
+                    if(sendImg4bitChunk(fds[c], col, row,
+                            chunks[c * CELL_CHUNKS + row * (MATRIX_COLS / 8) + col]) < 0)
+                        errors++;
+        return errors;
+    }
+
+}
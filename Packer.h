@@ -0,0 +1,58 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PACKER_H_
+#define PACKER_H_
+
+#include <stdint.h>
+
+#include "Chunk.h"
+#include "fmatdef.h"
+
+// Chunks making up the frame of one cell.
+#define CELL_CHUNKS  ((MATRIX_COLS / 8) * (MATRIX_ROWS / 8))
+
+namespace FlashMat {
+
+/**
+ * Convert a host-rendered RGB888 image spanning n cells (n * MATRIX_COLS by
+ * MATRIX_ROWS pixels, 3 bytes per pixel in R, G, B order, stride bytes per
+ * row) into the chunks of the cells, at COLOR_DEPTH (4) bits per color and
+ * in the layout of Chunk.h. chunks[c * CELL_CHUNKS + row * (MATRIX_COLS / 8)
+ * + col] receives the chunk (col, row) of cell c.
+ *
+ * Colors are truncated to 4 bits or, with dither, spread over a 4x4 ordered
+ * (Bayer) pattern, which keeps smooth gradients from banding.
+ */
+void packFrame(const uint8_t *rgb, int stride, int n, bool dither,
+               uint8_t chunks[][SIZE_8x8]);
+
+/**
+ * Send the chunks packed by packFrame() to the back buffers of the n cells.
+ * Returns the number of failed writes.
+ */
+int sendPackedFrame(int fds[], int n, const uint8_t chunks[][SIZE_8x8]);
+
+/**
+ * The kernel packFrame() was built with: "neon", "sse2" or "scalar".
+ */
+const char *packKernel();
+}
+
+#endif
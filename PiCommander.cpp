@@ -30,17 +30,39 @@
 namespace FlashMat
 {
 
+    static const WriteGate *writeGate = NULL;
+
+    void setWriteGate(const WriteGate *gate)
+    {
+        writeGate = gate;
+    }
+
+    int writeBlock(int fd, int command, int data[], int n)
+    {
+        if(writeGate != NULL && !writeGate->allow(fd))
+            return -1;
+        int res = wiringPiI2CWriteBlock(fd, command, data, n);
+        if(writeGate != NULL)
+            writeGate->done(fd, res);
+        return res;
+    }
+
+    int sendPing(int fd)
+    {
+        return writeBlock(fd, PKT_PING, NULL, 0);
+    }
+
     int sendFill(int fd, int color[3])
     {
         int command = PKT_FILL;
-        return wiringPiI2CWriteBlock(fd, command, color, 3);
+        return writeBlock(fd, command, color, 3);
     }
 
     int sendSwap(int fd, int type)
     {
         int command = PKT_SWAP;
         int tipo[1] = { type };
-        return wiringPiI2CWriteBlock(fd, command, tipo, 1);
+        return writeBlock(fd, command, tipo, 1);
     }
 
     int sendTextPars(int fd, int color[3], bool overlay, int bgColor[3],
@@ -60,7 +82,7 @@ namespace FlashMat
         args[8]  = monospace;
         args[9]  = charSpacing;
         args[10] = lineSpacing;
-        return wiringPiI2CWriteBlock(fd, command, args, 11);
+        return writeBlock(fd, command, args, 11);
     }
 
     int sendTextPosition(int fd, int x, int y)
@@ -71,7 +93,7 @@ namespace FlashMat
         args[1] = (x >> 8) & 0xFF;
         args[2] = y;
         args[3] = 0;
-        return wiringPiI2CWriteBlock(fd, command, args, 4);
+        return writeBlock(fd, command, args, 4);
     }
 
     int sendText(int fd, char *text)
@@ -79,6 +101,7 @@ namespace FlashMat
         int args[TEXT_PACKET_MAX_SIZE + 1];
         int command = PKT_TEXT;
         int chunkLen = strlen(text);
+        int res = 0;
         for(int i = 0; i < (chunkLen / TEXT_PACKET_MAX_SIZE) + 1; i++)
         {
             args[0] = i;
@@ -86,14 +109,16 @@ namespace FlashMat
             for(int j = 0; j < TEXT_PACKET_MAX_SIZE
                     && text[i * TEXT_PACKET_MAX_SIZE + j] != '\0'; j++, k++)
                 args[k + 1] = (int)text[i * TEXT_PACKET_MAX_SIZE + j];
-            int res  = wiringPiI2CWriteBlock(fd, command, args, k + 1);
+            if(writeBlock(fd, command, args, k + 1) < 0)
+                res = -1;
         }
+        return res;
     }
 
     int sendDrawText(int fd)
     {
         int command = PKT_DRAW_TEXT;
-        return wiringPiI2CWriteBlock(fd, command, NULL, 0);
+        return writeBlock(fd, command, NULL, 0);
     }
 
     int sendCellPosition(int fd, int x, int y)
@@ -104,7 +129,24 @@ namespace FlashMat
         args[1] = (x >> 8) & 0xFF;
         args[2] = y & 0xFF;
         args[3] = (y >> 8) & 0xFF;
-        return wiringPiI2CWriteBlock(fd, command, args, 4);
+        return writeBlock(fd, command, args, 4);
+    }
+
+    int sendImg4bitChunk(int fd, int col, int row, const uint8_t img[SIZE_8x8])
+    {
+        // The packet does not fit in an SMBus block (32 bytes), so it is
+        // written as a plain I2C message: same bytes on the bus.
+        uint8_t packet[3 + SIZE_8x8];
+        packet[0] = PKT_IMG_4bit_CHUNK;
+        packet[1] = col;
+        packet[2] = row;
+        memcpy(packet + 3, img, SIZE_8x8);
+        if(writeGate != NULL && !writeGate->allow(fd))
+            return -1;
+        int res = write(fd, packet, sizeof(packet)) == (ssize_t)sizeof(packet) ? 0 : -1;
+        if(writeGate != NULL)
+            writeGate->done(fd, res);
+        return res;
     }
 
 }
@@ -28,6 +28,21 @@
 #endif
 
 namespace FlashMat {
+/**
+ * Optional gate for every write to a cell: allow(fd) is asked before the
+ * write (if false, the write is skipped and fails with -1) and done(fd, res)
+ * is told the result. Used by the cell health tracking, see Health.h.
+ */
+struct WriteGate
+{
+    bool (*allow)(int fd);
+    void (*done)(int fd, int result);
+};
+
+void setWriteGate(const WriteGate *gate);
+int writeBlock(int fd, int command, int data[], int n);
+
+int sendPing(int fd);
 int sendFill(int fd, int color[3]);
 int sendSwap(int fd, int type);
 
@@ -37,6 +52,7 @@ int sendTextPosition(int fd, int x, int y);
 int sendText(int fd, char *text);
 int sendDrawText(int fd);
 int sendCellPosition(int fd, int x, int y);
+int sendImg4bitChunk(int fd, int col, int row, const uint8_t img[SIZE_8x8]);
 }
 #ifdef __cplusplus
     }
@@ -0,0 +1,68 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Region.h"
+
+
+namespace FlashMat
+{
+
+    // millis() wraps around: compare through the signed difference.
+    static bool before(unsigned int a, unsigned int b)
+    {
+        return (int)(a - b) < 0;
+    }
+
+    int regionsDue(const Region regions[], int n, unsigned int now, int due[])
+    {
+        int count = 0;
+        for(int r = 0; r < n; r++)
+        {
+            if(!regions[r].active || before(now, regions[r].due))
+                continue;
+            // Insertion sort by deadline: there are just a few regions.
+            int i = count++;
+            for(; i > 0 && before(regions[r].due, regions[due[i - 1]].due); i--)
+                due[i] = due[i - 1];
+            due[i] = r;
+        }
+        return count;
+    }
+
+    void regionReschedule(Region *region, int period, unsigned int now)
+    {
+        region->due += period;
+        if(before(region->due, now))
+            region->due = now;
+        region->active = true;
+    }
+
+    bool regionsNextDeadline(const Region regions[], int n, unsigned int *at)
+    {
+        bool found = false;
+        for(int r = 0; r < n; r++)
+            if(regions[r].active && (!found || before(regions[r].due, *at)))
+            {
+                *at = regions[r].due;
+                found = true;
+            }
+        return found;
+    }
+
+}
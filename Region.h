@@ -0,0 +1,75 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REGION_H_
+#define REGION_H_
+
+#include "Config.h"
+#include "Feed.h"
+#include "Scroller.h"
+#include "Settings.h"
+
+#define CLOCK_TEXT_SIZE  64
+
+namespace FlashMat {
+
+/**
+ * A group of cells showing its own input, with its own scroller and speed.
+ * The cells of a region are told their position relative to the region, so
+ * every region draws its text from x = 0.
+ *
+ * All the regions share the I2C bus: each region has the deadline of its
+ * next frame, and the due regions are served once each in deadline order
+ * (earliest deadline first). A region that missed its deadline is
+ * rescheduled no earlier than the time it was served, so a busy region can
+ * delay the others by at most one of its frames, never starve them.
+ */
+struct Region
+{
+    int n;
+    int cell[CELLS];        // indexes of the wall cells, left to right
+    int fds[CELLS];
+    Feed feed;
+    Scroller scroller;
+    char clock[CLOCK_TEXT_SIZE];  // the text of a clock region
+    int watch;              // event loop watch of the input file, or -1
+    bool scrolling;
+    bool active;            // it has a deadline
+    unsigned int due;       // millis() of its next frame, if active
+};
+
+/**
+ * Store in due the indexes of the active regions whose deadline is not
+ * after now, earliest deadline first. Returns how many they are.
+ */
+int regionsDue(const Region regions[], int n, unsigned int now, int due[]);
+
+/**
+ * Give the region the deadline of its next frame, period ms after the
+ * previous one but not before now.
+ */
+void regionReschedule(Region *region, int period, unsigned int now);
+
+/**
+ * The earliest deadline among the active regions; false if none is active.
+ */
+bool regionsNextDeadline(const Region regions[], int n, unsigned int *at);
+}
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "Scroller.h"
+#include "Settings.h"
+#include "Text.h"
+
+
+namespace FlashMat
+{
+
+    void scrollerLoad(Scroller *scroller, Feed *feed, GlyphCache *glyphs,
+                      int color[3], int bgColor[3])
+    {
+        scroller->feed = feed;
+        scroller->offset = 0;
+        scroller->width = 0;
+        scroller->firstLen = 0;
+        scroller->sent = false;
+        scroller->done = false;
+        scroller->glyphs = glyphs;
+        scroller->color = color;
+        scroller->bgColor = bgColor;
+        scroller->nRefs = 0;
+    }
+
+    // Stage the window at (x, y), glyphs included, and commit it.
+    static void drawFrame(Scroller *scroller, int fds[], int n, int x, int y,
+                          SkewStats *skew)
+    {
+        stageFrame(fds, n, x, y);
+        if(scroller->nRefs > 0)
+            drawGlyphs(scroller->glyphs, scroller->refs, scroller->nRefs, x, y,
+                       fds, n, scroller->color, scroller->bgColor);
+        commitFrame(fds, n, skew);
+    }
+
+    void scrollerSeek(Scroller *scroller, int offset)
+    {
+        scroller->offset = offset > 0 ? 0 : offset;
+        scroller->sent = false;
+    }
+
+    void scrollerResend(Scroller *scroller)
+    {
+        scroller->sent = false;
+    }
+
+    bool scrollerStill(Scroller *scroller, int fds[], int n, SkewStats *skew)
+    {
+        const char *text = feedAll(scroller->feed);
+        if(text == NULL)
+            return false;
+        char partial[SCROLL_WINDOW + 1];
+        int len = strlen(text);
+        if(glyphExpand(text, len, partial, SCROLL_WINDOW, scroller->refs,
+                       &scroller->nRefs, &scroller->width,
+                       &scroller->firstLen) < len
+                || displaylen(partial) > n * MATRIX_COLS)
+            return false;
+        for(int c = 0; c < n; c++)
+            sendText(fds[c], partial);
+        drawFrame(scroller, fds, n, COORD_X, COORD_Y, skew);
+        return true;
+    }
+
+    bool scrollerStep(Scroller *scroller, int fds[], int n, SkewStats *skew)
+    {
+        if(scrollerDone(scroller))
+            return false;
+        if(!scroller->sent)
+        {
+            char ahead[FEED_AHEAD + 1], partial[SCROLL_WINDOW + 1];
+            int len = feedPeek(scroller->feed, ahead, FEED_AHEAD);
+            glyphExpand(ahead, len, partial, SCROLL_WINDOW, scroller->refs,
+                        &scroller->nRefs, &scroller->width, &scroller->firstLen);
+            if(scroller->firstLen == 0)
+            {
+                scroller->done = true;
+                return false;
+            }
+            for(int c = 0; c < n; c++)
+                sendText(fds[c], partial);
+            scroller->sent = true;
+            if(scroller->offset <= -scroller->width)
+                scroller->offset = 0;
+        }
+        drawFrame(scroller, fds, n, scroller->offset, COORD_Y, skew);
+        if(--scroller->offset <= -scroller->width)
+        {
+            for(int i = 0; i < scroller->firstLen; i++)
+                feedAdvance(scroller->feed);
+            scroller->offset = 0;
+            scroller->sent = false;
+        }
+        return true;
+    }
+
+    bool scrollerDone(const Scroller *scroller)
+    {
+        return scroller->done;
+    }
+
+}
@@ -0,0 +1,90 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCROLLER_H_
+#define SCROLLER_H_
+
+#include "Feed.h"
+#include "Frame.h"
+#include "Glyph.h"
+
+// Characters sent to the cells at once (max for the I2C bus).
+#define SCROLL_WINDOW  30
+
+namespace FlashMat {
+
+/**
+ * A scrolling text, advanced one frame (i.e. one pixel) at a time.
+ *
+ * The cells only hold SCROLL_WINDOW characters: the window starts at the
+ * character being scrolled out on the left, and it is re-sent every time
+ * that character has completely left the wall. The glyphs in the window
+ * are drawn by the host at every frame (see Glyph.h).
+ */
+struct Scroller
+{
+    Feed *feed;   // the text; its current position is the window start
+    int offset;   // pixel offset of the window (0 or negative)
+    int width;    // width in pixels of the first character of the window
+    int firstLen; // length in bytes of the first character (or glyph token)
+    bool sent;    // the window has been sent to the cells
+    bool done;
+    GlyphCache *glyphs;
+    int *color;
+    int *bgColor;
+    GlyphRef refs[GLYPH_MAX_REFS];  // host-rendered glyphs in the window
+    int nRefs;
+};
+
+/**
+ * Scroll the text of feed (which already includes the LEAD_IN blanks)
+ * from its current position. Glyphs are drawn with the given colors, which
+ * must match the TEXT_PARS sent to the cells.
+ */
+void scrollerLoad(Scroller *scroller, Feed *feed, GlyphCache *glyphs,
+                  int color[3], int bgColor[3]);
+
+/**
+ * Resume the scroll at the given pixel offset of the current window (as
+ * saved from scroller->offset); the next step draws it.
+ */
+void scrollerSeek(Scroller *scroller, int offset);
+
+/**
+ * Send the window again at the next step (e.g. to a cell that was reset).
+ */
+void scrollerResend(Scroller *scroller);
+
+/**
+ * If the whole text of the feed fits on the n cells, draw it still at
+ * (COORD_X, COORD_Y), commit it and return true; otherwise return false
+ * without drawing anything.
+ */
+bool scrollerStill(Scroller *scroller, int fds[], int n, SkewStats *skew);
+
+/**
+ * Draw and commit the next frame on the given cells.
+ * Returns false once the whole text has scrolled by.
+ */
+bool scrollerStep(Scroller *scroller, int fds[], int n, SkewStats *skew);
+
+bool scrollerDone(const Scroller *scroller);
+}
+
+#endif
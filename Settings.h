@@ -0,0 +1,45 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SETTINGS_H_
+#define SETTINGS_H_
+
+/*
+ * Settings for the TweetMachine wall (cells layout and text appearance)
+ */
+
+#define ADDRESS1    0x41 //65
+#define ADDRESS2    0x40 //64
+#define ADDRESS3    0x3D //61
+#define ADDRESS4    0x3E //62
+#define CELLS       4  // cells of the default layout (and the most we drive)
+#define REGIONS_MAX CELLS
+#define FONT_ID     0
+#define CHARSPACING 1
+#define LINESPACING 1
+#define COORD_X     0
+#define COORD_Y     0
+#define MONOSPACE   0
+#define OVERLAY     0
+#define TEXT_SPEED  30 // the more, the slowest
+#define LEAD_IN     20 // blank characters scrolled in before the text
+#define STATE_FILE  "tweetmachine.state"  // default, see Config.h
+#define STATE_SAVE_INTERVAL  10000  // ms between two saves while scrolling
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "State.h"
+
+
+namespace FlashMat
+{
+
+    void stateClear(State *state)
+    {
+        memset(state, 0, sizeof(*state));
+    }
+
+    void stateSetInput(RegionState *region, const char *input)
+    {
+        unsigned long hash = 2166136261UL;
+        size_t length = 0;
+        for(; input[length] != '\0'; length++)
+            hash = ((hash ^ (unsigned char)input[length]) * 16777619UL)
+                   & 0xFFFFFFFFUL;
+        region->inputLength = length;
+        region->inputHash = hash;
+    }
+
+    bool stateSameInput(const RegionState *region, const char *input)
+    {
+        RegionState given;
+        stateSetInput(&given, input);
+        return given.inputLength == region->inputLength
+               && given.inputHash == region->inputHash;
+    }
+
+    int stateLoad(State *state, const char *path)
+    {
+        stateClear(state);
+        FILE *input = fopen(path, "r");
+        if(input == NULL)
+            return -1;
+        char line[CONFIG_PATH_SIZE + 32];
+        bool valid = true;
+        while(valid && fgets(line, sizeof(line), input))
+        {
+            int *p = state->textPars;
+            if(strncmp(line, "cell ", 5) == 0)
+            {
+                CellState *cell = &state->cell[state->cells];
+                valid = state->cells < CELLS && sscanf(line + 5, "%i %d %d",
+                        &cell->address, &cell->x, &cell->y) == 3;
+                state->cells++;
+            }
+            else if(strncmp(line, "textpars ", 9) == 0)
+            {
+                valid = sscanf(line + 9, "%d %d %d %d %d %d %d %d %d %d %d",
+                               &p[0], &p[1], &p[2], &p[3], &p[4], &p[5], &p[6],
+                               &p[7], &p[8], &p[9], &p[10]) == TEXT_PARS_ARGS;
+                state->hasTextPars = valid;
+            }
+            else if(strcmp(line, "handoff\n") == 0)
+                state->handoff = true;
+            else if(strncmp(line, "region ", 7) == 0)
+            {
+                RegionState *region = &state->region[state->regions];
+                valid = state->regions < REGIONS_MAX
+                        && sscanf(line + 7, "%d %lu %lu %d %lu %lx",
+                                  &region->mode, &region->message,
+                                  &region->messageOffset, &region->offset,
+                                  &region->inputLength,
+                                  &region->inputHash) == 6;
+                state->regions++;
+            }
+            else if(strncmp(line, "mark ", 5) == 0)
+            {
+                // The input position of the region above, if any.
+                valid = state->regions > 0;
+                if(valid)
+                {
+                    RegionState *region = &state->region[state->regions - 1];
+                    FeedMark *mark = &region->mark;
+                    valid = sscanf(line + 5, "%lld %lu %lu %lu %d %lu %lld %lld",
+                                   &mark->raw, &mark->consumed, &mark->message,
+                                   &mark->messageOffset, &mark->stars,
+                                   &region->consumed, &region->inputSize,
+                                   &region->inputMtime) == 8;
+                    region->hasMark = valid;
+                }
+            }
+        }
+        fclose(input);
+        if(!valid)
+        {
+            stateClear(state);
+            return -1;
+        }
+        return 0;
+    }
+
+    int stateSave(const State *state, const char *path)
+    {
+        char temp[CONFIG_PATH_SIZE + 8];
+        snprintf(temp, sizeof(temp), "%s.tmp", path);
+        FILE *output = fopen(temp, "w");
+        if(output == NULL)
+            return -1;
+        for(int c = 0; c < state->cells; c++)
+            fprintf(output, "cell 0x%02X %d %d\n", state->cell[c].address,
+                    state->cell[c].x, state->cell[c].y);
+        if(state->hasTextPars)
+        {
+            fprintf(output, "textpars");
+            for(int i = 0; i < TEXT_PARS_ARGS; i++)
+                fprintf(output, " %d", state->textPars[i]);
+            fprintf(output, "\n");
+        }
+        for(int r = 0; r < state->regions; r++)
+        {
+            const RegionState *region = &state->region[r];
+            fprintf(output, "region %d %lu %lu %d %lu %lx\n", region->mode,
+                    region->message, region->messageOffset, region->offset,
+                    region->inputLength, region->inputHash);
+            if(region->hasMark)
+                fprintf(output, "mark %lld %lu %lu %lu %d %lu %lld %lld\n",
+                        region->mark.raw, region->mark.consumed,
+                        region->mark.message, region->mark.messageOffset,
+                        region->mark.stars, region->consumed,
+                        region->inputSize, region->inputMtime);
+        }
+        if(state->handoff)
+            fprintf(output, "handoff\n");
+        if(fclose(output) != 0)
+            return -1;
+        return rename(temp, path);
+    }
+
+}
@@ -0,0 +1,99 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATE_H_
+#define STATE_H_
+
+#include "Config.h"
+#include "Feed.h"
+#include "Settings.h"
+
+#define TEXT_PARS_ARGS  11
+
+namespace FlashMat {
+
+/**
+ * What the cells and the scroller were doing when the program stopped,
+ * saved so that a restart can go on from there without initializing the
+ * cells again and without scrolling the lead-in again.
+ *
+ * The cells are only trusted to still hold what the state says after a
+ * deliberate handoff (handoff is set): after a crash or a power loss they
+ * may have been reset, and a reset cell acknowledges the writes all the same.
+ */
+struct CellState
+{
+    int address;
+    int x;
+    int y;
+};
+
+struct RegionState
+{
+    int mode;                       // the input, see USAGE in main.cpp:
+    unsigned long inputLength;      //  the string given for it is only
+    unsigned long inputHash;        //  recognized, see stateSetInput()
+    unsigned long message;          // scroll position: see Feed
+    unsigned long messageOffset;
+    int offset;                     // scroll position: see Scroller
+    bool hasMark;                   // the same position, in the input file:
+    FeedMark mark;                  //  the last chunk start passed,
+    unsigned long consumed;         //  the characters consumed (see Feed),
+    long long inputSize;            //  and the file they refer to
+    long long inputMtime;
+};
+
+struct State
+{
+    int cells;
+    CellState cell[CELLS];          // x and y are relative to the region
+    int textPars[TEXT_PARS_ARGS];   // the arguments of the last TEXT_PARS
+    bool hasTextPars;
+    int regions;
+    RegionState region[REGIONS_MAX];
+    bool handoff;                   // saved on purpose, the cells left as they are
+};
+
+void stateClear(State *state);
+
+/**
+ * Record the string given as the input of the region (a path or the text
+ * itself, of any length) by its length and FNV-1a hash.
+ */
+void stateSetInput(RegionState *region, const char *input);
+
+/**
+ * Whether input is the string recorded by stateSetInput().
+ */
+bool stateSameInput(const RegionState *region, const char *input);
+
+/**
+ * Returns 0 on success, -1 if there is no (valid) saved state; in that
+ * case state is cleared.
+ */
+int stateLoad(State *state, const char *path);
+
+/**
+ * Save atomically (the file is written aside and then renamed), so that a
+ * crash never leaves a truncated state behind. Returns 0 on success.
+ */
+int stateSave(const State *state, const char *path);
+}
+
+#endif
@@ -0,0 +1,282 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+#include "Glyph.h"
+#include "Settings.h"
+#include "Text.h"
+
+
+int displaylen(char* s)
+{
+    int lengths [95] =
+    {
+        0x06, // 0x20 ( 32)
+        0x01, // 0x21 ( 33)
+        0x03, // 0x22 ( 34)
+        0x06, // 0x23 ( 35)
+        0x05, // 0x24 ( 36)
+        0x06, // 0x25 ( 37)
+        0x05, // 0x26 ( 38)
+        0x01, // 0x27 ( 39)
+        0x03, // 0x28 ( 40)
+        0x03, // 0x29 ( 41)
+        0x05, // 0x2A ( 42)
+        0x05, // 0x2B ( 43)
+        0x02, // 0x2C ( 44)
+        0x03, // 0x2D ( 45)
+        0x02, // 0x2E ( 46)
+        0x05, // 0x2F ( 47)
+        0x04, // 0x30 ( 48)
+        0x03, // 0x31 ( 49)
+        0x04, // 0x32 ( 50)
+        0x04, // 0x33 ( 51)
+        0x05, // 0x34 ( 52)
+        0x04, // 0x35 ( 53)
+        0x04, // 0x36 ( 54)
+        0x04, // 0x37 ( 55)
+        0x04, // 0x38 ( 56)
+        0x04, // 0x39 ( 57)
+        0x01, // 0x3A ( 58)
+        0x02, // 0x3B ( 59)
+        0x03, // 0x3C ( 60)
+        0x04, // 0x3D ( 61)
+        0x03, // 0x3E ( 62)
+        0x05, // 0x3F ( 63)
+        0x07, // 0x40 ( 64)
+        0x04, // 0x41 ( 65)
+        0x04, // 0x42 ( 66)
+        0x04, // 0x43 ( 67)
+        0x04, // 0x44 ( 68)
+        0x04, // 0x45 ( 69)
+        0x04, // 0x46 ( 70)
+        0x04, // 0x47 ( 71)
+        0x04, // 0x48 ( 72)
+        0x03, // 0x49 ( 73)
+        0x05, // 0x4A ( 74)
+        0x04, // 0x4B ( 75)
+        0x04, // 0x4C ( 76)
+        0x05, // 0x4D ( 77)
+        0x05, // 0x4E ( 78)
+        0x05, // 0x4F ( 79)
+        0x04, // 0x50 ( 80)
+        0x05, // 0x51 ( 81)
+        0x04, // 0x52 ( 82)
+        0x04, // 0x53 ( 83)
+        0x05, // 0x54 ( 84)
+        0x05, // 0x55 ( 85)
+        0x05, // 0x56 ( 86)
+        0x07, // 0x57 ( 87)
+        0x05, // 0x58 ( 88)
+        0x05, // 0x59 ( 89)
+        0x04, // 0x5A ( 90)
+        0x03, // 0x5B ( 91)
+        0x05, // 0x5C ( 92)
+        0x03, // 0x5D ( 93)
+        0x05, // 0x5E ( 94)
+        0x06, // 0x5F ( 95)
+        0x02, // 0x60 ( 96)
+        0x04, // 0x61 ( 97)
+        0x04, // 0x62 ( 98)
+        0x03, // 0x63 ( 99)
+        0x04, // 0x64 (100)
+        0x04, // 0x65 (101)
+        0x04, // 0x66 (102)
+        0x04, // 0x67 (103)
+        0x04, // 0x68 (104)
+        0x01, // 0x69 (105)
+        0x03, // 0x6A (106)
+        0x03, // 0x6B (107)
+        0x03, // 0x6C (108)
+        0x05, // 0x6D (109)
+        0x04, // 0x6E (110)
+        0x04, // 0x6F (111)
+        0x04, // 0x70 (112)
+        0x04, // 0x71 (113)
+        0x04, // 0x72 (114)
+        0x04, // 0x73 (115)
+        0x03, // 0x74 (116)
+        0x04, // 0x75 (117)
+        0x05, // 0x76 (118)
+        0x05, // 0x77 (119)
+        0x04, // 0x78 (120)
+        0x04, // 0x79 (121)
+        0x04, // 0x7A (122)
+        0x04, // 0x7B (123)
+        0x01, // 0x7C (124)
+        0x04, // 0x7D (125)
+        0x07, // 0x7E (126)
+    };
+    int strl = strlen(s);
+    int res = 0;
+    for(int i = 0; i < strl; i++)
+        res += lengths[s[i] - 32];
+    // Add charspacing.
+    res += strl * CHARSPACING;
+    return res;
+}
+
+// Decode the UTF-8 sequence at s; *len is set to the number of bytes used.
+// Returns -1 for an invalid (or truncated) sequence.
+static long decodeUtf8(const char *s, int *len)
+{
+    unsigned char c = s[0];
+    int extra;
+    long cp;
+    *len = 1;
+    if(c >= 0xF0 && c < 0xF8)
+    {
+        extra = 3;
+        cp = c & 0x07;
+    }
+    else if(c >= 0xE0)
+    {
+        extra = 2;
+        cp = c & 0x0F;
+    }
+    else if(c >= 0xC0)
+    {
+        extra = 1;
+        cp = c & 0x1F;
+    }
+    else
+        return -1;
+    for(int k = 1; k <= extra; k++)
+    {
+        if(((unsigned char)s[k] & 0xC0) != 0x80)
+            return -1;
+        cp = (cp << 6) | (s[k] & 0x3F);
+    }
+    *len = extra + 1;
+    return cp;
+}
+
+// Code points that take no room on their own: combining marks, zero-width
+// joiners and spaces, variation selectors (e.g. the emoji presentation
+// selector after a heart) and the emoji skin tone modifiers.
+static bool zeroWidth(long cp)
+{
+    return (cp >= 0x0300 && cp <= 0x036F)      // combining diacritical marks
+        || cp == 0x00AD                        // soft hyphen
+        || (cp >= 0x200B && cp <= 0x200F)      // zero width space, (non-)joiner, marks
+        || (cp >= 0x2060 && cp <= 0x2064)      // word joiner, invisible operators
+        || (cp >= 0x20D0 && cp <= 0x20FF)      // combining marks for symbols (keycaps)
+        || (cp >= 0xFE00 && cp <= 0xFE0F)      // variation selectors
+        || cp == 0xFEFF                        // byte order mark
+        || (cp >= 0x1F3FB && cp <= 0x1F3FF)    // skin tone modifiers
+        || (cp >= 0xE0000 && cp <= 0xE01EF);   // tags, variation selectors supplement
+}
+
+int parser(const char * text, char * out)
+{
+    bool link = false;
+    return parserChunk(text, out, &link);
+}
+
+int parserChunk(const char * text, char * out, bool * link)
+{
+    int length = strlen(text);
+    int cont = 0;
+    int i = 0;
+    if(*link)
+    {
+        // The rest of a link cut by the previous chunk.
+        while(text[i] != ' ' && text[i] != '\0')
+            i++;
+        if(text[i] == '\0')
+        {
+            out[0] = '\0';
+            return 0;
+        }
+        i++;
+        *link = false;
+    }
+    for(; i < length; i++)
+    {
+        unsigned char c = text[i];
+        if(c < 32)  // newlines and other control characters
+            out[cont++] = ' ';
+        else
+            if(c > 127)
+            {
+                int len;
+                long cp = decodeUtf8(text + i, &len);
+                i += len - 1;
+                switch(cp)
+                {
+                case 0xE8: //è
+                    out[cont++] = 'e';
+                    out[cont++] = (char)39;
+                    break;
+                case 0xE0: //à
+                    out[cont++] = 'a';
+                    out[cont++] = (char)39;
+                    break;
+                case 0xF2: //ò
+                    out[cont++] = 'o';
+                    out[cont++] = (char)39;
+                    break;
+                case 0xEC: //ì
+                    out[cont++] = 'i';
+                    out[cont++] = (char)39;
+                    break;
+                case 0xF9: //ù
+                    out[cont++] = 'u';
+                    out[cont++] = (char)39;
+                    break;
+                case 0x2018: //‘
+                case 0x2019: //’
+                    out[cont++] = (char)39;
+                    break;
+                case 0x201C: //“
+                case 0x201D: //”
+                    out[cont++] = '"';
+                    break;
+                case 0x2026: //…
+                    out[cont++] = '.';
+                    out[cont++] = '.';
+                    out[cont++] = '.';
+                    break;
+                default:
+                    // Drawn by the host if the bundled font has it.
+                    if(zeroWidth(cp))
+                        break;
+                    if(FlashMat::glyphAvailable(cp))
+                        cont += FlashMat::glyphEncode(cp, out + cont);
+                    else
+                        out[cont++] = '*';
+                    break;
+                }
+            }
+            // Remove links (and the blank after them).
+            else
+                if(strncmp(text + i, "http://", 7) == 0
+                        || strncmp(text + i, "https://", 8) == 0)
+                {
+                    while(text[i] != ' ' && text[i] != '\0')
+                        i++;
+                    *link = text[i] == '\0';
+                }
+                else
+                    out[cont++] = c;
+    }
+    out[cont] = '\0';
+    return cont;
+}
@@ -0,0 +1,49 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TEXT_H_
+#define TEXT_H_
+
+// A 2-byte UTF-8 sequence may become a 4-byte glyph token.
+#define PARSER_OUT_SIZE(len)  (2 * (len) + 1)
+
+/**
+ * Width in pixels of the string s, as drawn by the cells with font FONT_ID
+ * (character spacing included).
+ */
+int displaylen(char* s);
+
+/**
+ * Normalize a text read from the input into out: newlines become spaces,
+ * links are removed and UTF-8 sequences are mapped onto printable ASCII.
+ * Characters the cells cannot draw become glyph tokens (see Glyph.h) if the
+ * bundled font has them, '*' otherwise.
+ * out must have room for PARSER_OUT_SIZE(strlen(text)) bytes.
+ * Returns the length of out.
+ */
+int parser(const char * text, char * out);
+
+/**
+ * As parser(), for a text normalized in consecutive chunks: *link is true
+ * if the chunk ends inside a link, the rest of which is then removed from
+ * the next chunk. Start with *link false.
+ */
+int parserChunk(const char * text, char * out, bool * link);
+
+#endif
@@ -0,0 +1,449 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * CPU micro-benchmarks of the host side, run on recorded tweet corpora (as
+ * written by download.py). The cells are replaced by /dev/null, so only the
+ * time spent by the host is measured: parsing, measuring the text, encoding
+ * the packets and planning the frames, plus packing host-rendered frames.
+ *
+ *    ./bench [<corpus> ...]
+ *
+ * Without arguments, the corpora in bench/corpus are used. Before timing,
+ * the streamed feed is checked against parser() run on the whole input,
+ * and the packer kernel against a plain per-pixel reference: the exit
+ * status is 1 if they disagree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <wiringPiI2C.h>
+
+#include "Feed.h"
+#include "Frame.h"
+#include "Glyph.h"
+#include "Packer.h"
+#include "PiCommander.h"
+#include "Scroller.h"
+#include "Settings.h"
+#include "Text.h"
+
+// Each benchmark is repeated for at least this long.
+#ifndef BENCH_MIN_MS
+#define BENCH_MIN_MS  300
+#endif
+
+#ifndef BENCH_CORPUS_DIR
+#define BENCH_CORPUS_DIR  "bench/corpus"
+#endif
+
+// Text windows measured by the displaylen() benchmark.
+#define BENCH_WINDOWS  4096
+
+// Frame rate host-rendered frames must sustain.
+#define BENCH_TARGET_FPS  60
+// Distinct frames cycled through by the packer benchmark.
+#define BENCH_FRAMES      8
+// Random frames packed by both packFrame() and the reference before timing.
+#define BENCH_CHECK_FRAMES  2000
+
+using namespace FlashMat;
+
+static const char *defaultCorpora[] = {
+    BENCH_CORPUS_DIR "/ascii.txt",
+    BENCH_CORPUS_DIR "/utf8.txt",
+};
+
+static int fds[CELLS];
+static int color[3] = {255, 127, 0};
+static int bgColor[3] = {0, 0, 0};
+
+static double nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void report(const char *name, double ns, double ops, const char *unit,
+                   double perSecond)
+{
+    printf("  %-22s %12.1f ns/op %14.0f %s/s\n", name, ns / ops, perSecond, unit);
+}
+
+// Read the whole file; returns NULL if it cannot be read.
+static char *readCorpus(const char *path, long *len)
+{
+    FILE *file = fopen(path, "rb");
+    if(file == NULL)
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    *len = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *text = (char *)malloc(*len + 1);
+    if(text == NULL || (long)fread(text, 1, *len, file) != *len)
+    {
+        free(text);
+        fclose(file);
+        return NULL;
+    }
+    text[*len] = '\0';
+    fclose(file);
+    return text;
+}
+
+static void benchParser(const char *text, long len)
+{
+    char *out = (char *)malloc(PARSER_OUT_SIZE(len));
+    double start = nowNs(), elapsed;
+    long runs = 0;
+    do
+    {
+        parser(text, out);
+        runs++;
+    }
+    while((elapsed = nowNs() - start) < BENCH_MIN_MS * 1e6);
+    report("parser", elapsed, (double)runs * len, "byte",
+           runs * len / (elapsed / 1e9));
+    free(out);
+}
+
+// The windows sent to the cells while scrolling text (parsed), one per
+// character, as the scroller cuts them.
+static int scrollWindows(const char *text, char windows[][SCROLL_WINDOW + 1])
+{
+    int len = strlen(text), n = 0;
+    GlyphRef refs[GLYPH_MAX_REFS];
+    int nRefs, width, firstLen;
+    for(int pos = 0; pos < len && n < BENCH_WINDOWS; pos += firstLen, n++)
+    {
+        glyphExpand(text + pos, len - pos, windows[n], SCROLL_WINDOW, refs,
+                    &nRefs, &width, &firstLen);
+        if(firstLen == 0)
+            break;
+    }
+    return n;
+}
+
+static void benchDisplaylen(char windows[][SCROLL_WINDOW + 1], int n)
+{
+    double start = nowNs(), elapsed;
+    long calls = 0;
+    volatile int sink = 0;
+    do
+    {
+        for(int w = 0; w < n; w++)
+            sink += displaylen(windows[w]);
+        calls += n;
+    }
+    while((elapsed = nowNs() - start) < BENCH_MIN_MS * 1e6);
+    report("displaylen", elapsed, calls, "call", calls / (elapsed / 1e9));
+}
+
+static void benchGlyphExpand(const char *text)
+{
+    static char windows[BENCH_WINDOWS][SCROLL_WINDOW + 1];
+    double start = nowNs(), elapsed;
+    long calls = 0;
+    do
+        calls += scrollWindows(text, windows);
+    while((elapsed = nowNs() - start) < BENCH_MIN_MS * 1e6);
+    report("glyphExpand", elapsed, calls, "call", calls / (elapsed / 1e9));
+}
+
+// Encode (and write to /dev/null) the packets of one frame: see Frame.h.
+static void benchEncoders(char windows[][SCROLL_WINDOW + 1], int n)
+{
+    uint8_t chunk[SIZE_8x8];
+    memset(chunk, 0x5A, sizeof(chunk));
+    const char *names[] = {"sendText", "sendTextPosition", "sendDrawText",
+                           "sendSwap", "sendImg4bitChunk"};
+    for(int packet = 0; packet < 5; packet++)
+    {
+        double start = nowNs(), elapsed;
+        long sent = 0;
+        do
+        {
+            for(int i = 0; i < 256; i++, sent++)
+            {
+                int fd = fds[i % CELLS];
+                switch(packet)
+                {
+                    case 0: sendText(fd, windows[i % n]); break;
+                    case 1: sendTextPosition(fd, -(i & 7), COORD_Y); break;
+                    case 2: sendDrawText(fd); break;
+                    case 3: sendSwap(fd, SWAP_SYNC); break;
+                    case 4: sendImg4bitChunk(fd, i & 3, 0, chunk); break;
+                }
+            }
+        }
+        while((elapsed = nowNs() - start) < BENCH_MIN_MS * 1e6);
+        report(names[packet], elapsed, sent, "packet", sent / (elapsed / 1e9));
+    }
+}
+
+// Scroll the whole corpus through the feed, as main.cpp does, without the
+// delay between the frames.
+static void benchFrames(const char *path)
+{
+    static Feed feed;
+    static GlyphCache glyphs;
+    Scroller scroller;
+    SkewStats skew;
+    initSkewStats(&skew, SWAP_SKEW_BUDGET_US);
+    glyphCacheInit(&glyphs);
+    double start = nowNs(), elapsed;
+    long frames = 0;
+    do
+    {
+        if(feedOpenFile(&feed, path) < 0)
+            return;
+        scrollerLoad(&scroller, &feed, &glyphs, color, bgColor);
+        while(scrollerStep(&scroller, fds, CELLS, &skew))
+            frames++;
+        feedClose(&feed);
+    }
+    while((elapsed = nowNs() - start) < BENCH_MIN_MS * 1e6);
+    report("frame (scrollerStep)", elapsed, frames, "frame",
+           frames / (elapsed / 1e9));
+    printf("  %-22s %12lu hits %13lu misses\n", "glyph cache",
+           glyphs.hits, glyphs.misses);
+}
+
+// The input as streamed by a Feed (without the lead-in) must be the whole
+// input normalized at once.
+static bool checkFeed(const char *path)
+{
+    long len;
+    char *text = readCorpus(path, &len);
+    if(text == NULL)
+        return false;
+    char *expected = (char *)malloc(PARSER_OUT_SIZE(len));
+    char *streamed = (char *)malloc(PARSER_OUT_SIZE(len) + LEAD_IN);
+    int expectedLen = parser(text, expected);
+    static Feed feed;
+    feedOpenFile(&feed, path);
+    int n = 0;
+    char c[2];
+    while(feedPeek(&feed, c, 1) == 1 && n < PARSER_OUT_SIZE(len) + LEAD_IN)
+    {
+        streamed[n++] = c[0];
+        feedAdvance(&feed);
+    }
+    feedClose(&feed);
+    bool ok = n == expectedLen + LEAD_IN
+              && memcmp(streamed + LEAD_IN, expected, expectedLen) == 0;
+    printf("feed %s: %d characters, %s\n", path, n - LEAD_IN,
+           ok ? "as parser()" : "DIFFERENT from parser()");
+    free(streamed);
+    free(expected);
+    free(text);
+    return ok;
+}
+
+// Write the inputs that are hard to stream (words, links and UTF-8 runs
+// longer than FEED_CARRY, links cut anywhere) to a temporary file.
+static bool writeFeedCases(char path[])
+{
+    int fd = mkstemp(path);
+    if(fd < 0)
+        return false;
+    FILE *out = fdopen(fd, "w");
+    for(int i = 0; i < 50; i++)
+    {
+        fprintf(out, "abc http://e.com/");
+        for(int q = 0; q < 600; q++)
+            fputc('q', out);
+        fprintf(out, " def %s", i % 2 ? "https://t.co/" : "\n");
+        for(int q = 0; q < 300 + i; q++)
+            fputc('r', out);
+        fprintf(out, "\nghi *** ");
+    }
+    for(int i = 0; i < 600; i++)
+        fputc('x', out);
+    for(int i = 0; i < 300; i++)
+        fputs("\xC3\xA8\xCF\x80", out);    // e grave, pi
+    // The link starts around the forced cut.
+    for(int n = FEED_CARRY - 16; n < FEED_CARRY + 16; n++)
+    {
+        fputc(' ', out);
+        for(int i = 0; i < n; i++)
+            fputc('y', out);
+        fputs(n % 2 ? "https://x.y/z" : "http://x.y/z", out);
+        for(int i = 0; i < FEED_CARRY; i++)
+            fputc('z', out);
+    }
+    fputs(" end\n", out);
+    return fclose(out) == 0;
+}
+
+/*
+ * The reference for packFrame(): every pixel quantised on its own (see the
+ * Bayer matrix in Packer.cpp) and stored with chunkSetPixel().
+ */
+static void packReference(const uint8_t *rgb, int stride, int n, bool dither,
+                          uint8_t chunks[][SIZE_8x8])
+{
+    static const uint8_t bayer[4][4] =
+    {
+        {  0,  8,  2, 10 },
+        { 12,  4, 14,  6 },
+        {  3, 11,  1,  9 },
+        { 15,  7, 13,  5 }
+    };
+    static const int planeOf[3] = { R, G, B };
+    memset(chunks, 0, n * CELL_CHUNKS * SIZE_8x8);
+    for(int y = 0; y < MATRIX_ROWS; y++)
+        for(int x = 0; x < n * MATRIX_COLS; x++)
+            for(int ch = 0; ch < 3; ch++)
+            {
+                int v = rgb[y * stride + 3 * x + ch]
+                        + (dither ? bayer[y & 3][x & 3] : 0);
+                if(v > 0xFF)
+                    v = 0xFF;
+                int c = x / MATRIX_COLS, cx = x % MATRIX_COLS;
+                chunkSetPixel(chunks[c * CELL_CHUNKS + (y / 8) * (MATRIX_COLS / 8)
+                                     + cx / 8],
+                              planeOf[ch], cx % 8, y % 8, v >> 4);
+            }
+}
+
+// Compare packFrame() with the reference on random frames (saturated ones
+// included, for the dithering). Returns the number of frames that differ.
+static int checkPacker()
+{
+    int stride = CELLS * MATRIX_COLS * 3 + 5;   // not a multiple of 16
+    uint8_t *rgb = (uint8_t *)malloc(MATRIX_ROWS * stride);
+    static uint8_t chunks[CELLS * CELL_CHUNKS][SIZE_8x8];
+    static uint8_t expected[CELLS * CELL_CHUNKS][SIZE_8x8];
+    int wrong = 0;
+    srand(1);
+    for(int f = 0; f < BENCH_CHECK_FRAMES; f++)
+    {
+        for(int i = 0; i < MATRIX_ROWS * stride; i++)
+            rgb[i] = (f % 3 == 0 && (rand() & 1)) ? 0xFF : rand() & 0xFF;
+        bool dither = f & 1;
+        packFrame(rgb, stride, CELLS, dither, chunks);
+        packReference(rgb, stride, CELLS, dither, expected);
+        if(memcmp(chunks, expected, sizeof(chunks)) != 0)
+            wrong++;
+    }
+    free(rgb);
+    return wrong;
+}
+
+// A moving color gradient over the whole wall, BENCH_FRAMES frames of it.
+static uint8_t *renderFrames(int stride)
+{
+    uint8_t *rgb = (uint8_t *)malloc(BENCH_FRAMES * MATRIX_ROWS * stride);
+    for(int f = 0; f < BENCH_FRAMES; f++)
+        for(int y = 0; y < MATRIX_ROWS; y++)
+            for(int x = 0; x < CELLS * MATRIX_COLS; x++)
+            {
+                uint8_t *px = rgb + (f * MATRIX_ROWS + y) * stride + 3 * x;
+                px[0] = (x * 2 + f * 8) & 0xFF;
+                px[1] = (y * 32 + x) & 0xFF;
+                px[2] = 0xFF - ((x * 2 + f * 8) & 0xFF);
+            }
+    return rgb;
+}
+
+static void benchPacker(bool dither, bool send)
+{
+    int stride = CELLS * MATRIX_COLS * 3;
+    uint8_t *rgb = renderFrames(stride);
+    static uint8_t chunks[CELLS * CELL_CHUNKS][SIZE_8x8];
+    double start = nowNs(), elapsed;
+    long frames = 0;
+    do
+    {
+        packFrame(rgb + (frames % BENCH_FRAMES) * MATRIX_ROWS * stride, stride,
+                  CELLS, dither, chunks);
+        if(send)
+            sendPackedFrame(fds, CELLS, chunks);
+        frames++;
+    }
+    while((elapsed = nowNs() - start) < BENCH_MIN_MS * 1e6);
+    const char *name = send ? "packFrame + send" : dither ? "packFrame (dither)"
+                                                          : "packFrame";
+    report(name, elapsed, frames, "frame", frames / (elapsed / 1e9));
+    // Share of the frame time at BENCH_TARGET_FPS.
+    printf("  %-22s %11.3f %% of the %d fps budget\n", "",
+           elapsed / frames * BENCH_TARGET_FPS / 1e7, BENCH_TARGET_FPS);
+    free(rgb);
+}
+
+int main(int argc, char *argv[])
+{
+    const char **corpora = (const char **)argv + 1;
+    int nCorpora = argc - 1;
+    if(nCorpora == 0)
+    {
+        corpora = defaultCorpora;
+        nCorpora = sizeof(defaultCorpora) / sizeof(defaultCorpora[0]);
+    }
+    for(int c = 0; c < CELLS; c++)
+        fds[c] = wiringPiI2CSetup(0x40 + c);
+
+    char cases[] = "/tmp/benchfeedXXXXXX";
+    bool feedOk = writeFeedCases(cases) && checkFeed(cases);
+    unlink(cases);
+    for(int i = 0; i < nCorpora; i++)
+        feedOk = checkFeed(corpora[i]) && feedOk;
+    if(!feedOk)
+        return 1;
+
+    int wrong = checkPacker();
+    printf("packer (%s): %d/%d random frames match the reference\n",
+           packKernel(), BENCH_CHECK_FRAMES - wrong, BENCH_CHECK_FRAMES);
+    if(wrong > 0)
+        return 1;
+    printf("packer (%s): %d cells, %dx%d pixels\n", packKernel(), CELLS,
+           CELLS * MATRIX_COLS, MATRIX_ROWS);
+    benchPacker(false, false);
+    benchPacker(true, false);
+    benchPacker(true, true);
+
+    static char windows[BENCH_WINDOWS][SCROLL_WINDOW + 1];
+    for(int i = 0; i < nCorpora; i++)
+    {
+        long len;
+        char *text = readCorpus(corpora[i], &len);
+        if(text == NULL)
+        {
+            fprintf(stderr, "Cannot read %s\n", corpora[i]);
+            return 1;
+        }
+        char *parsed = (char *)malloc(PARSER_OUT_SIZE(len));
+        parser(text, parsed);
+        int n = scrollWindows(parsed, windows);
+        printf("%s: %ld bytes, %d windows, %d cells\n", corpora[i], len, n, CELLS);
+        benchParser(text, len);
+        benchDisplaylen(windows, n);
+        benchGlyphExpand(parsed);
+        benchEncoders(windows, n);
+        benchFrames(corpora[i]);
+        free(parsed);
+        free(text);
+    }
+    return 0;
+}
@@ -19,9 +19,16 @@
 
 /**
  * USAGE
- * ./program <mode> <value>
+ * ./program <mode> <value> [<config>]
  * <mode> can either be 0 (thus <value> is a string to be displayed)
  * or 1 (<value> is a path to a file)
+ * or 2 (<value> is a strftime() format for the local time; used by the
+ * regions of the configuration file, see Config.h)
+ * <config> is an optional configuration file (see Config.h), read again
+ * on SIGHUP
+ *
+ * SIGINT and SIGTERM blank the cells and exit; SIGUSR1 exits leaving the
+ * current frame on the cells, for a warm restart.
  */
 
 
@@ -29,349 +36,483 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <signal.h>
+#include <time.h>
 #include <sys/types.h>
-#include <sys/signal.h>
 #include <unistd.h>
 #include <wiringPi.h>
 #include <wiringPiI2C.h>
 
+#include "Config.h"
+#include "EventLoop.h"
+#include "Feed.h"
+#include "Frame.h"
+#include "Glyph.h"
+#include "Health.h"
 #include "PiCommander.h"
+#include "Region.h"
+#include "Scroller.h"
+#include "Settings.h"
+#include "State.h"
+#include "Text.h"
 
 
 using namespace FlashMat;
 
-#define ADDRESS1    0x41 //65
-#define ADDRESS2    0x40 //64
-#define ADDRESS3    0x3D //61
-#define ADDRESS4    0x3E //62
-#define FONT_ID     0
-#define CHARSPACING 1
-#define LINESPACING 1
-#define COORD_X     0
-#define COORD_Y     0
-#define MONOSPACE   0
-#define OVERLAY     0
-#define TEXT_SPEED  30 // the more, the slowest
-
-int RED_COLOR  [3] = MAKE_RGB(255, 127, 0);
 int BLACK_COLOR[3] = MAKE_RGB(0, 0, 0);
 
 
-int displaylen(char* s)
+static Config config;
+static const char *configPath;   // NULL if there is no configuration file
+static int mainMode;             // the input of the main region
+static const char *mainValue;
+static State state;              // what the cells hold, saved for warm restarts
+static int fds[CELLS];           // the cells, as in config.cell
+static int cellX[CELLS];         // the position of each cell in its region
+static SkewStats skew;
+static GlyphCache glyphs;
+static Region regions[REGIONS_MAX];
+static EventLoop loop;
+
+
+static int regionMode(int r)
+{
+    return r == 0 ? mainMode : config.region[r].mode;
+}
+
+static const char *regionValue(int r)
+{
+    return r == 0 ? mainValue : config.region[r].value;
+}
+
+static int regionSpeed(int r)
+{
+    return r == 0 ? config.speed : config.region[r].speed;
+}
+
+// The period of the frames of a scrolling region: a clock wider than its
+// region scrolls like the main region, its speed being the refresh period.
+static int scrollSpeed(int r)
+{
+    return regionMode(r) == 2 ? config.speed : regionSpeed(r);
+}
+
+// Blank every cell of the region (FILL with black, then SWAP).
+static void blank(Region *region)
 {
-    int lengths [95] =
+    for(int c = 0; c < region->n; c++)
+        sendFill(region->fds[c], BLACK_COLOR);
+    commitFrame(region->fds, region->n, &skew);
+}
+
+// Group the cells by region, left to right.
+static void layout()
+{
+    for(int r = 0; r < config.regions; r++)
+    {
+        regions[r].n = 0;
+        regions[r].watch = -1;
+    }
+    for(int c = 0; c < config.cells; c++)
     {
-        0x06, // 0x20 ( 32)
-        0x01, // 0x21 ( 33)
-        0x03, // 0x22 ( 34)
-        0x06, // 0x23 ( 35)
-        0x05, // 0x24 ( 36)
-        0x06, // 0x25 ( 37)
-        0x05, // 0x26 ( 38)
-        0x01, // 0x27 ( 39)
-        0x03, // 0x28 ( 40)
-        0x03, // 0x29 ( 41)
-        0x05, // 0x2A ( 42)
-        0x05, // 0x2B ( 43)
-        0x02, // 0x2C ( 44)
-        0x03, // 0x2D ( 45)
-        0x02, // 0x2E ( 46)
-        0x05, // 0x2F ( 47)
-        0x04, // 0x30 ( 48)
-        0x03, // 0x31 ( 49)
-        0x04, // 0x32 ( 50)
-        0x04, // 0x33 ( 51)
-        0x05, // 0x34 ( 52)
-        0x04, // 0x35 ( 53)
-        0x04, // 0x36 ( 54)
-        0x04, // 0x37 ( 55)
-        0x04, // 0x38 ( 56)
-        0x04, // 0x39 ( 57)
-        0x01, // 0x3A ( 58)
-        0x02, // 0x3B ( 59)
-        0x03, // 0x3C ( 60)
-        0x04, // 0x3D ( 61)
-        0x03, // 0x3E ( 62)
-        0x05, // 0x3F ( 63)
-        0x07, // 0x40 ( 64)
-        0x04, // 0x41 ( 65)
-        0x04, // 0x42 ( 66)
-        0x04, // 0x43 ( 67)
-        0x04, // 0x44 ( 68)
-        0x04, // 0x45 ( 69)
-        0x04, // 0x46 ( 70)
-        0x04, // 0x47 ( 71)
-        0x04, // 0x48 ( 72)
-        0x03, // 0x49 ( 73)
-        0x05, // 0x4A ( 74)
-        0x04, // 0x4B ( 75)
-        0x04, // 0x4C ( 76)
-        0x05, // 0x4D ( 77)
-        0x05, // 0x4E ( 78)
-        0x05, // 0x4F ( 79)
-        0x04, // 0x50 ( 80)
-        0x05, // 0x51 ( 81)
-        0x04, // 0x52 ( 82)
-        0x04, // 0x53 ( 83)
-        0x05, // 0x54 ( 84)
-        0x05, // 0x55 ( 85)
-        0x05, // 0x56 ( 86)
-        0x07, // 0x57 ( 87)
-        0x05, // 0x58 ( 88)
-        0x05, // 0x59 ( 89)
-        0x04, // 0x5A ( 90)
-        0x03, // 0x5B ( 91)
-        0x05, // 0x5C ( 92)
-        0x03, // 0x5D ( 93)
-        0x05, // 0x5E ( 94)
-        0x06, // 0x5F ( 95)
-        0x02, // 0x60 ( 96)
-        0x04, // 0x61 ( 97)
-        0x04, // 0x62 ( 98)
-        0x03, // 0x63 ( 99)
-        0x04, // 0x64 (100)
-        0x04, // 0x65 (101)
-        0x04, // 0x66 (102)
-        0x04, // 0x67 (103)
-        0x04, // 0x68 (104)
-        0x01, // 0x69 (105)
-        0x03, // 0x6A (106)
-        0x03, // 0x6B (107)
-        0x03, // 0x6C (108)
-        0x05, // 0x6D (109)
-        0x04, // 0x6E (110)
-        0x04, // 0x6F (111)
-        0x04, // 0x70 (112)
-        0x04, // 0x71 (113)
-        0x04, // 0x72 (114)
-        0x04, // 0x73 (115)
-        0x03, // 0x74 (116)
-        0x04, // 0x75 (117)
-        0x05, // 0x76 (118)
-        0x05, // 0x77 (119)
-        0x04, // 0x78 (120)
-        0x04, // 0x79 (121)
-        0x04, // 0x7A (122)
-        0x04, // 0x7B (123)
-        0x01, // 0x7C (124)
-        0x04, // 0x7D (125)
-        0x07, // 0x7E (126)
+        Region *region = &regions[config.cell[c].region];
+        cellX[c] = region->n * MATRIX_COLS;
+        region->cell[region->n] = c;
+        region->fds[region->n] = fds[c];
+        region->n++;
+    }
+}
+
+// Send TEXT_PARS, unless the cells already have the same parameters.
+static void syncTextPars()
+{
+    int pars[TEXT_PARS_ARGS] =
+    {
+        config.color[0], config.color[1], config.color[2], config.overlay,
+        config.bgColor[0], config.bgColor[1], config.bgColor[2],
+        FONT_ID, MONOSPACE, CHARSPACING, LINESPACING
     };
-    int strl = strlen(s);
-    int res = 0;
-    for(int i = 0; i < strl; i++)
-        res += lengths[s[i] - 32];
-    // Add charspacing.
-    res += strl * CHARSPACING;
-    return res;
+    if(state.hasTextPars && memcmp(state.textPars, pars, sizeof(pars)) == 0)
+        return;
+    for(int c = 0; c < config.cells; c++)
+        sendTextPars(fds[c], config.color, config.overlay, config.bgColor,
+                     FONT_ID, MONOSPACE, CHARSPACING, LINESPACING);
+    memcpy(state.textPars, pars, sizeof(pars));
+    state.hasTextPars = true;
 }
 
-void parser(char * text)
+// Send CELL_POSITION, unless the saved state says the cells already have it.
+static void syncCellPositions()
 {
-    // TODO Use a dynamic array.
-    char text2[10000];
-    int length = strlen(text);
-    int cont = 0;
-    for(int i = 0; i < length; i++, cont++)
+    bool known = state.cells == config.cells;
+    for(int c = 0; c < config.cells && known; c++)
+        known = state.cell[c].address == config.cell[c].address
+                && state.cell[c].x == cellX[c] && state.cell[c].y == 0;
+    if(known)
+        return;
+    // Inform the cells about their position (inside their region).
+    state.cells = config.cells;
+    for(int c = 0; c < config.cells; c++)
     {
-        if(text[i] == '\n')
-            text2[cont] = ' ';
-        else
-            if((int)text[i] < 0 || (int)text[i] > 127)
-            {
-                switch((int)text[i])
-                {
-                case 195:
-                {
-                    switch((int)text[i + 1])
-                    {
-                    case 168: //è
-                        text2[cont++] = 'e';
-                        text2[cont] = (char)39;
-                        break;
-                    case 160: //à
-                        text2[cont++] = 'a';
-                        text2[cont] = (char)39;
-                        break;
-                    case 178: //ò
-                        text2[cont++] = 'o';
-                        text2[cont] = (char)39;
-                        break;
-                    case 172: //ì
-                        text2[cont++] = 'i';
-                        text2[cont] = (char)39;
-                        break;
-                    case 185: //ù
-                        text2[cont++] = 'u';
-                        text2[cont] = (char)39;
-                        break;
-                    }
-                    i++;
-                    break;
-                }
-                case 226:
-                {
-                    if((int)text[i + 2] == 166 && (int)text[i + 1] == 128)
-                    {
-                        text2[cont++] = '.';
-                        text2[cont++] = '.';
-                        text2[cont] = '.';
-                        i += 2;
-                    }
-                    break;
-                }
-                default:
-                    text2[cont] = '*';
-                    break;
-                }
-            }
-            // Remove links.
-            // TODO Who wrote this shit? Switch to strncmp()!!!
-            else
-                if((text[i] == 'h' && text[i + 1] == 't' && text[i + 2] == 't'
-                        && text[i + 3] == 'p' && text[i + 4] == ':' && text[i + 5] == '/'
-                        && text[i + 6] == '/') || (text[i] == 'h' && text[i + 1] == 't'
-                                                   && text[i + 2] == 't' && text[i + 3] == 'p' && text[i + 4] == 's'
-                                                   && text[i + 5] == ':' && text[i + 6] == '/' && text[i + 7] == '/'))
-                {
-                    while(text[i] != ' ' && text[i] != '\0')
-                        i++;
-                }
-                else
-                    text2[cont] = text[i];
+        sendCellPosition(fds[c], cellX[c], 0);
+        state.cell[c].address = config.cell[c].address;
+        state.cell[c].x = cellX[c];
+        state.cell[c].y = 0;
+    }
+    // Cells we did not know about might have any text parameters.
+    state.hasTextPars = false;
+}
+
+static void saveState()
+{
+    state.regions = config.regions;
+    for(int r = 0; r < config.regions; r++)
+    {
+        RegionState *saved = &state.region[r];
+        Region *region = &regions[r];
+        saved->mode = regionMode(r);
+        stateSetInput(saved, regionValue(r));
+        saved->message = region->scrolling ? region->feed.message : 0;
+        saved->messageOffset = region->scrolling ? region->feed.messageOffset : 0;
+        saved->offset = region->scrolling ? region->scroller.offset : 0;
+        saved->hasMark = region->scrolling && region->feed.size >= 0;
+        saved->mark = region->feed.mark;
+        saved->consumed = region->feed.consumed;
+        saved->inputSize = region->feed.size;
+        saved->inputMtime = region->feed.mtime;
     }
-    text2[cont] = '\0';
-    int i = 0;
-    for(int j = 0; j < cont; j++)
+    if(stateSave(&state, config.statePath) < 0)
+        perror(config.statePath);
+}
+
+// The local time, formatted as the value of clock region r says.
+static void clockText(int r, char text[CLOCK_TEXT_SIZE])
+{
+    time_t now = time(NULL);
+    struct tm local;
+    localtime_r(&now, &local);
+    if(strftime(text, CLOCK_TEXT_SIZE, regionValue(r), &local) == 0)
+        text[0] = '\0';
+}
+
+// Open the input of the region according to its mode (see USAGE); it is
+// read lazily.
+static void openFeed(int r)
+{
+    Region *region = &regions[r];
+    feedClose(&region->feed);
+    switch(regionMode(r))
     {
-        if(text2[j] != '\0')
+    case 0:
+        feedOpenString(&region->feed, regionValue(r));
+        break;
+    case 1:
+        feedOpenFile(&region->feed, regionValue(r));
+        break;
+    case 2:
+        clockText(r, region->clock);
+        feedOpenString(&region->feed, region->clock);
+        break;
+    default:
+        feedOpenString(&region->feed, "");
+        break;
+    }
+}
+
+// Bring the feed of region r to its saved position: straight to the saved
+// chunk if the input file is unchanged, counting the messages otherwise.
+static bool resumeFeed(int r)
+{
+    Feed *feed = &regions[r].feed;
+    const RegionState *saved = &state.region[r];
+    if(saved->hasMark && feed->size == saved->inputSize
+            && feed->mtime == saved->inputMtime
+            && feedResume(feed, &saved->mark, saved->consumed))
+        return true;
+    return feedSeek(feed, saved->message, saved->messageOffset);
+}
+
+/**
+ * Start showing the current input of region r. Empty input blanks the
+ * region and a text that fits it is drawn once: in both cases the region
+ * sleeps until its input changes (a clock is drawn again after its period).
+ * Otherwise the text scrolls, from the saved position if resume is true,
+ * and its first frame is drawn at once; at the end of the text, show() is
+ * called again, which reads a scrolling clock anew.
+ */
+static void show(int r, bool resume)
+{
+    Region *region = &regions[r];
+    region->scrolling = false;
+    region->active = false;
+    if(region->n == 0)
+        return;
+    openFeed(r);
+    const char *text = feedAll(&region->feed);
+    syncTextPars();
+    scrollerLoad(&region->scroller, &region->feed, &glyphs, config.color,
+                 config.bgColor);
+    if(text != NULL && text[strspn(text, " ")] == '\0')
+        blank(region);
+    else if(!scrollerStill(&region->scroller, region->fds, region->n, &skew))
+    {
+        const RegionState *saved = &state.region[r];
+        if(resume && r < state.regions && saved->mode == regionMode(r)
+                && stateSameInput(saved, regionValue(r))
+                && resumeFeed(r))
+            scrollerSeek(&region->scroller, saved->offset);
+        region->scrolling = true;
+        region->due = millis();
+        if(!scrollerStep(&region->scroller, region->fds, region->n, &skew))
         {
-            text[i] = text2[j];
-            i++;
+            show(r, false);
+            return;
         }
+        regionReschedule(region, scrollSpeed(r), millis());
+        return;
+    }
+    if(regionMode(r) == 2)
+    {
+        region->due = millis();
+        regionReschedule(region, regionSpeed(r), millis());
     }
-    text[i] = '\0';
+}
+
+// Serve a due region: its next frame (or a clock refresh).
+static void serve(int r)
+{
+    Region *region = &regions[r];
+    char clock[CLOCK_TEXT_SIZE];
+    if(!region->scrolling)
+    {
+        // Nothing to send if the clock still shows the right time.
+        clockText(r, clock);
+        if(strcmp(clock, region->clock) == 0)
+            regionReschedule(region, regionSpeed(r), millis());
+        else
+            show(r, false);
+    }
+    else if(!scrollerStep(&region->scroller, region->fds, region->n, &skew))
+        show(r, false);
+    else
+        regionReschedule(region, scrollSpeed(r), millis());
+}
+
+// Serve the due regions once each, earliest deadline first.
+static void serveDue()
+{
+    int due[REGIONS_MAX];
+    int n = regionsDue(regions, config.regions, millis(), due);
+    for(int i = 0; i < n; i++)
+        serve(due[i]);
+}
+
+// Arm the timer for the earliest deadline: the next frame of a region or
+// the next PING to a cell that is down. Nothing to wait for: no wakeups.
+static void schedule()
+{
+    unsigned int at, retry;
+    bool found = regionsNextDeadline(regions, config.regions, &at);
+    if(healthNextRetry(&retry) && (!found || (int)(retry - at) < 0))
+    {
+        at = retry;
+        found = true;
+    }
+    int delay = found ? (int)(at - millis()) : -1;
+    eventLoopSchedule(&loop, found && delay < 0 ? 0 : delay);
+}
+
+// A cell is back after a reset: tell it again what it has lost.
+static void resyncCell(int c)
+{
+    sendCellPosition(fds[c], cellX[c], 0);
+    sendTextPars(fds[c], config.color, config.overlay, config.bgColor,
+                 FONT_ID, MONOSPACE, CHARSPACING, LINESPACING);
+}
+
+// Probe the cells that are down; the ones that are back get everything
+// again, the current text of their region included.
+static void recoverCells()
+{
+    int recovered[CELLS];
+    bool redraw[REGIONS_MAX] = { false };
+    int n = healthPoll(millis(), recovered);
+    for(int i = 0; i < n; i++)
+    {
+        int r = config.cell[recovered[i]].region;
+        resyncCell(recovered[i]);
+        if(regions[r].scrolling)
+            scrollerResend(&regions[r].scroller);
+        else
+            redraw[r] = true;
+    }
+    for(int r = 0; r < config.regions; r++)
+        if(redraw[r])
+            show(r, false);
+}
+
+// SIGHUP: read the configuration again. The cells keep their state.
+static void reload()
+{
+    Config fresh;
+    configDefaults(&fresh);
+    if(configPath == NULL || configLoad(&fresh, configPath) < 0)
+    {
+        fprintf(stderr, "SIGHUP: no configuration to reload\n");
+        return;
+    }
+    if(!configSameLayout(&config, &fresh))
+    {
+        fprintf(stderr, "SIGHUP: regions and cells are only read at startup\n");
+        fresh.regions = config.regions;
+        memcpy(fresh.region, config.region, sizeof(fresh.region));
+        fresh.cells = config.cells;
+        memcpy(fresh.cell, config.cell, sizeof(fresh.cell));
+    }
+    config = fresh;
+    skew.budgetUs = config.skewBudgetUs;
+    syncTextPars();
+    // Redraw the still texts with the new parameters.
+    for(int r = 0; r < config.regions; r++)
+        if(!regions[r].scrolling)
+            show(r, false);
 }
 
 int main(int argc, char* argv[])
 {
-    assert(argc > 1 && argc <= 3);  // assert we've only 2 args
-    int fd2 = wiringPiI2CSetup(ADDRESS2);
-    int fd1 = wiringPiI2CSetup(ADDRESS1);
-    int fd3 = wiringPiI2CSetup(ADDRESS3);
-    int fd4 = wiringPiI2CSetup(ADDRESS4);
-    assert(fd1 >= 0 && fd2 >= 0);
-    assert(fd3 >= 0 && fd4 >= 0);
-    // Inform the cells about their absolute position.
-    sendCellPosition(fd1, 0, 0);
-    sendCellPosition(fd2, MATRIX_COLS, 0);
-    sendCellPosition(fd3, 2 * MATRIX_COLS, 0);
-    sendCellPosition(fd4, 3 * MATRIX_COLS, 0);
+    assert(argc > 1 && argc <= 4);  // assert we've only 2 args (+ config)
+    configDefaults(&config);
+    configPath = argc > 3 ? argv[3] : NULL;
+    if(configPath != NULL && configLoad(&config, configPath) < 0)
+        perror(configPath);
+    stateLoad(&state, config.statePath);
+    if(state.handoff)
+    {
+        // Trust the cells once: a crash from now on must not look like a
+        // handoff.
+        state.handoff = false;
+        stateSave(&state, config.statePath);
+    }
+    else
+    {
+        // The cells may have been reset with the host (e.g. a power loss):
+        // only the scroll position is still good.
+        state.cells = 0;
+        state.hasTextPars = false;
+    }
+    int addresses[CELLS];
+    for(int c = 0; c < config.cells; c++)
+    {
+        addresses[c] = config.cell[c].address;
+        fds[c] = wiringPiI2CSetup(addresses[c]);
+        assert(fds[c] >= 0);
+    }
+    healthInit(fds, addresses, config.cells);
+    layout();
+    syncCellPositions();
+    initSkewStats(&skew, config.skewBudgetUs);
     if(argc == 1)  // if there is no argument, send a black fill
     {
-        sendFill(fd1, BLACK_COLOR);
-        sendFill(fd2, BLACK_COLOR);
-        sendFill(fd3, BLACK_COLOR);
-        sendFill(fd4, BLACK_COLOR);
-        sendSwap(fd1, 0x00);
-        sendSwap(fd2, 0x00);
-        sendSwap(fd3, 0x00);
-        sendSwap(fd4, 0x00);
+        for(int r = 0; r < config.regions; r++)
+            blank(&regions[r]);
+        return 0;
     }
-    else // display the argument
+    /** We display the text in this way:
+        - Send text string (with sendText)
+        - Send text parameters, such as string color, background color, font, spacing, etc... (with sendTextPars)
+        - Send text position, the top and the left position (with sendTextPosition)
+        - Actually draw the text in the back buffer (with sendDrawText)
+        - Send swap to flip buffers (with sendSwap)
+
+        With a scrolling text, the first two commands can be sent only once and will be kept in memory by FlashMat matrixs;
+        whereas the last three needs to be issued every time we want to scroll the text.
+
+        The commands here are duplicated because we simulate a fake BROADCAST: in fact, we just send
+        every command to every slave attached at the I2C channel. Due to how the FlashMat system is built,
+        every single cell will draw and display its own part correctly.
+
+        Position and draw are staged on every cell first (stageFrame), then
+        all the swaps are committed back-to-back with SWAP_SYNC (commitFrame),
+        so that neighbouring cells flip together and the text does not shear.
+
+        Frames are paced by the timer of the event loop (one pixel per tick).
+        The input is streamed (see Feed.h): only a small window of text ahead
+        of the scroll position is kept, and the input is opened again every
+        time the whole text has scrolled by.
+
+        The state of the cells and the scroll position are saved (see State.h)
+        so that a restart goes on where the previous run stopped, without
+        sending again what the cells already know.
+
+        The cells can be split into regions (see Config.h and Region.h), each
+        with its own input and speed; the frames of the regions are
+        interleaved on the bus by deadline.
+      */
+    mainMode = atoi(argv[1]);
+    mainValue = argc > 2 ? argv[2] : "";
+    glyphCacheInit(&glyphs);
+    if(eventLoopInit(&loop) < 0)
+    {
+        perror("eventLoopInit");
+        return 1;
+    }
+    for(int r = 0; r < config.regions; r++)
     {
-        /** We display the text in this way:
-            - Send text string (with sendText)
-            - Send text parameters, such as string color, background color, font, spacing, etc... (with sendTextPars)
-            - Send text position, the top and the left position (with sendTextPosition)
-            - Actually draw the text in the back buffer (with sendDrawText)
-            - Send swap to flip buffers (with sendSwap)
-
-            With a scrolling text, the first two commands can be sent only once and will be kept in memory by FlashMat matrixs;
-            whereas the last three needs to be issued every time we want to scroll the text.
-
-            The commands here are duplicated because we simulate a fake BROADCAST: in fact, we just send
-            every command to every slave attached at the I2C channel. Due to how the FlashMat system is built,
-            every single cell will draw and display its own part correctly.
-          */
-        while(true)
+        feedOpenString(&regions[r].feed, "");
+        if(regionMode(r) == 1)
+            regions[r].watch = eventLoopWatch(&loop, regionValue(r));
+        show(r, true);
+    }
+    schedule();
+    unsigned int lastSave = millis();
+    int arg, signo = 0;
+    while(true)
+    {
+        Event ev = eventLoopWait(&loop, &arg);
+        if(ev == EV_ERROR)
+            break;
+        if(ev == EV_SIGNAL && arg == SIGHUP)
+            reload();
+        else if(ev == EV_SIGNAL)
         {
-            /*
-             * We have a "total_blank" string with all the characters to display
-             * (taken from Twitter thanks to tweepy),
-             * and a "partial" with max 30 char (max for I2C bus).
-             * "partial" is a scrollable window that take everytime
-             * 30 char from "total_blank" and we send it to FlashMat.
-             */
-            sendTextPars(fd1, RED_COLOR, OVERLAY, BLACK_COLOR, FONT_ID, MONOSPACE,
-                         CHARSPACING, LINESPACING);
-            sendTextPars(fd2, RED_COLOR, OVERLAY, BLACK_COLOR, FONT_ID, MONOSPACE,
-                         CHARSPACING, LINESPACING);
-            sendTextPars(fd3, RED_COLOR, OVERLAY, BLACK_COLOR, FONT_ID, MONOSPACE,
-                         CHARSPACING, LINESPACING);
-            sendTextPars(fd4, RED_COLOR, OVERLAY, BLACK_COLOR, FONT_ID, MONOSPACE,
-                         CHARSPACING, LINESPACING);
-            // TODO What is this?
-            // TODO Use dynamic arrays.
-            char total_blank[10000], partial[31], chars[4];
-            for(int i = 0; i < 20; i++)
-            {
-                total_blank[i] = ' ';
-            }
-            total_blank[20] = '\0';
-            int modalita = atoi(argv[1]);
-            // TODO Use a dynamic array.
-            char testo[10000];
-            size_t char_letti;
-            switch(modalita)
+            signo = arg;
+            break;
+        }
+        else if(ev == EV_TIMER)
+        {
+            recoverCells();
+            serveDue();
+            // Several frames may be committed between two ticks, or none.
+            if(skew.frames - skew.reported >= SWAP_SKEW_REPORT_FRAMES)
             {
-            case 0:
-                strcat(total_blank, argv[2]);
-                break;
-            case 1:
-                // TODO Why stdio.h? <fstream> is better.
-                FILE *input;
-                input = fopen(argv[2], "rb");
-                while(fgets(testo, sizeof(testo), input))
-                {
-                    parser(testo);
-                    strcat(total_blank, testo);
-                }
-                fclose(input);
-                break;
+                if(skew.overBudget > 0)
+                    reportSkew(stderr, &skew);
+                skew.reported = skew.frames;
             }
-            int total_length = strlen(total_blank);
-            int i = 0, predictedChars;
-            while(total_length > i)
+            // Saved now and then, so that even a crash restarts close by.
+            if(millis() - lastSave >= STATE_SAVE_INTERVAL)
             {
-                strncpy(partial, total_blank + i, 30);
-                partial[30] = '\0';
-                sendText(fd1, partial);
-                sendText(fd2, partial);
-                sendText(fd3, partial);
-                sendText(fd4, partial);
-                strncpy(chars, partial, 1);
-                chars[1] = '\0';
-                predictedChars = displaylen(chars);
-                for(int j = 0; j > -predictedChars; j--)
-                {
-                    sendTextPosition(fd1, j, COORD_Y);
-                    sendTextPosition(fd2, j, COORD_Y);
-                    sendTextPosition(fd3, j, COORD_Y);
-                    sendTextPosition(fd4, j, COORD_Y);
-                    sendDrawText(fd1);
-                    sendDrawText(fd2);
-                    sendDrawText(fd3);
-                    sendDrawText(fd4);
-                    sendSwap(fd1, 0x00);
-                    sendSwap(fd2, 0x00);
-                    sendSwap(fd3, 0x00);
-                    sendSwap(fd4, 0x00);
-                    delay(TEXT_SPEED);
-                }
-                i++;
+                saveState();
+                lastSave = millis();
             }
         }
+        else if(ev == EV_INPUT)
+            for(int r = 0; r < config.regions; r++)
+                if(regions[r].watch >= 0 && (arg & (1 << regions[r].watch))
+                        && !regions[r].scrolling)
+                    show(r, false);
+        schedule();
     }
+    state.handoff = signo == SIGUSR1;
+    saveState();
+    healthReport(stderr);
+    // Do not leave the cells mid-frame. SIGUSR1 asks to keep the current
+    // frame instead, for a restart that picks up from the saved state.
+    if(signo != SIGUSR1)
+        for(int r = 0; r < config.regions; r++)
+            blank(&regions[r]);
+    for(int r = 0; r < config.regions; r++)
+        feedClose(&regions[r].feed);
+    eventLoopClose(&loop);
     return 0;
 }
@@ -0,0 +1,86 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * A stand-in for wiringPi on machines without an I2C bus: the clock
+ * functions are real, the cells are /dev/null (so that packets written
+ * with write() go nowhere) and block writes are copied into a dummy bus
+ * buffer and dropped.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <time.h>
+
+#include "wiringPi.h"
+#include "wiringPiI2C.h"
+
+// As in linux/i2c.h.
+#define I2C_SMBUS_BLOCK_MAX  32
+
+/*
+ * The last block written, laid out as the i2c_smbus_data the patched
+ * wiringPi hands to the kernel (after the command byte). It is volatile so
+ * that, once inlined (e.g. with LTO), the writes cannot be optimised away
+ * together with the packing done by the callers.
+ */
+static volatile unsigned char bus[1 + I2C_SMBUS_BLOCK_MAX + 1];
+
+static unsigned long long nowUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+void delay(unsigned int howLong)
+{
+    struct timespec ts;
+    ts.tv_sec = howLong / 1000;
+    ts.tv_nsec = (long)(howLong % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+unsigned int millis(void)
+{
+    return (unsigned int)(nowUs() / 1000);
+}
+
+unsigned int micros(void)
+{
+    return (unsigned int)nowUs();
+}
+
+int wiringPiI2CSetup(const int devId)
+{
+    (void)devId;
+    return open("/dev/null", O_WRONLY | O_CLOEXEC);
+}
+
+int wiringPiI2CWriteBlock(int fd, int command, int data[], int n)
+{
+    int quantity = n < I2C_SMBUS_BLOCK_MAX ? n : I2C_SMBUS_BLOCK_MAX;
+    (void)fd;
+    bus[0] = command;
+    bus[1] = quantity;
+    for(int i = 0; i < quantity; i++)
+        bus[i + 2] = data[i];
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WIRINGPI_STUB_H_
+#define WIRINGPI_STUB_H_
+
+/**
+ * The part of wiringPi used by TweetMachine, for building (and running the
+ * benchmarks) on machines without the library. See stub/wiringPi.c.
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void delay(unsigned int howLong);
+unsigned int millis(void);
+unsigned int micros(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
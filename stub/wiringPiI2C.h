@@ -0,0 +1,36 @@
+/**
+ * TweetMachine project - https://github.com/lucach/tweetmachine
+ * Copyright © 2014 Demetrio Carrara <carrarademetrio@gmail.com>
+ * Copyright © 2014 Luca Chiodini <luca@chiodini.org>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef WIRINGPII2C_STUB_H_
+#define WIRINGPII2C_STUB_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int wiringPiI2CSetup(const int devId);
+
+// Added by the wiringPi patch described in README.md.
+int wiringPiI2CWriteBlock(int fd, int command, int data[], int n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif